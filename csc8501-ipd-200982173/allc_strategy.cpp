@@ -4,6 +4,6 @@ Action ALLC::decideAction(const GameState&) {
     return Action::Cooperate;
 }
 
-std::string ALLC::name() const {
+std::string_view ALLC::name() const {
     return "ALLC";
 }
\ No newline at end of file
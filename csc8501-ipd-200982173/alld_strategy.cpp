@@ -4,6 +4,6 @@ Action ALLD::decideAction(const GameState&) {
     return Action::Defect;
 }
 
-std::string ALLD::name() const {
+std::string_view ALLD::name() const {
     return "ALLD";
 }
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <fstream>
+#include <algorithm>
+#include <sstream>
+#include <filesystem>
+#include <stdexcept>
+#include <type_traits>
+#include "checkpoint.hpp"
+
+namespace {
+    constexpr char checkpointMagic[8] = { 'I', 'P', 'D', 'C', 'K', 'P', 'T', '3' };
+
+    template <typename V>
+    void writeValue(std::ostream& out, const V& value) {
+        static_assert(std::is_trivially_copyable_v<V>);
+        out.write(reinterpret_cast<const char*>(&value), sizeof(V));
+    }
+
+    template <typename V>
+    V readValue(std::istream& in) {
+        static_assert(std::is_trivially_copyable_v<V>);
+        V value{};
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(V))) {
+            throw std::runtime_error("Error - checkpoint file is truncated");
+        }
+        return value;
+    }
+
+    void writeString(std::ostream& out, const std::string& text) {
+        writeValue<std::uint64_t>(out, text.size());
+        out.write(text.data(), text.size());
+    }
+
+    std::string readString(std::istream& in) {
+        std::string text(readValue<std::uint64_t>(in), '\0');
+        if (!in.read(text.data(), text.size())) {
+            throw std::runtime_error("Error - checkpoint file is truncated");
+        }
+        return text;
+    }
+
+    void writeDoubles(std::ostream& out, const double* values, std::uint64_t count) {
+        writeValue<std::uint64_t>(out, count);
+        out.write(reinterpret_cast<const char*>(values), count * sizeof(double));
+    }
+
+    std::vector<double> readDoubles(std::istream& in) {
+        std::vector<double> values(readValue<std::uint64_t>(in));
+        if (!in.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(double))) {
+            throw std::runtime_error("Error - checkpoint file is truncated");
+        }
+        return values;
+    }
+}
+
+// Every option that changes the evolutionary trajectory or the files it streams to. Generations is
+// left out so a resumed run may be extended.
+std::string Checkpoint::optionsKey(const CommandOptions& options) {
+    std::ostringstream key;
+    key.precision(17);
+    key << "rounds=" << options.rounds << ";repeats=" << options.repeats << ";strategies=";
+    for (const auto& strat : options.strategies) {
+        key << strat << ",";
+    }
+    key << ";payoff=" << options.t << "," << options.r << "," << options.p << "," << options.s
+        << ";noise=" << options.noiseOn << ";epsilon=" << options.epsilon << ";seed=" << options.seed
+        << ";population=" << options.population << ";scb=" << options.scb
+        << ";dynamics=" << options.dynamics << ";mutation=" << options.mutation << ";response=" << options.responseRate
+        << ";format=" << options.format;
+    return key.str();
+}
+
+void Checkpoint::save(const std::string& path, const EvolutionCheckpoint& checkpoint) {
+    // Write beside the target and rename, so a crash mid-write never leaves a broken checkpoint
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Checkpoint file " + tempPath + " could not be created");
+        }
+
+        out.write(checkpointMagic, sizeof(checkpointMagic));
+        writeString(out, checkpoint.optionsKey);
+        writeValue<std::int32_t>(out, checkpoint.generation);
+
+        const DynamicsState& state = checkpoint.dynamicsState;
+        writeDoubles(out, state.shares.data(), state.shares.size());
+        writeValue<std::uint64_t>(out, state.recentShares.size());
+        for (const auto& shares : state.recentShares) {
+            writeDoubles(out, shares.data(), shares.size());
+        }
+        writeValue<std::int32_t>(out, state.cycleLength);
+        writeValue<double>(out, state.stepSize);
+
+        const StrategyMatrix<double>& matrix = *checkpoint.fitnessMatrix;
+        writeValue<std::uint64_t>(out, matrix.size());
+        writeDoubles(out, matrix.row(0), matrix.size() * matrix.size());
+
+        writeString(out, checkpoint.historyPath);
+        writeValue<std::uint64_t>(out, checkpoint.historyBytes);
+        writeValue<std::uint8_t>(out, checkpoint.leaderboardMerged);
+        writeString(out, checkpoint.leaderboardBefore);
+
+        if (!out.good()) {
+            throw std::runtime_error("Checkpoint file " + tempPath + " could not be written");
+        }
+    }
+    std::filesystem::rename(tempPath, path);
+}
+
+EvolutionCheckpoint Checkpoint::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Checkpoint file " + path + " could not be opened");
+    }
+
+    char magic[sizeof(checkpointMagic)];
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), checkpointMagic)) {
+        throw std::runtime_error("Error - " + path + " is not an IPD checkpoint");
+    }
+
+    EvolutionCheckpoint checkpoint;
+    checkpoint.optionsKey = readString(in);
+    checkpoint.generation = readValue<std::int32_t>(in);
+
+    DynamicsState& state = checkpoint.dynamicsState;
+    state.shares = readDoubles(in);
+    state.recentShares.resize(readValue<std::uint64_t>(in));
+    for (auto& shares : state.recentShares) {
+        shares = readDoubles(in);
+    }
+    state.cycleLength = readValue<std::int32_t>(in);
+    state.stepSize = readValue<double>(in);
+
+    size_t matrixSize = readValue<std::uint64_t>(in);
+    std::vector<double> cells = readDoubles(in);
+    if (cells.size() != matrixSize * matrixSize) {
+        throw std::runtime_error("Error - checkpoint payoff matrix is corrupt");
+    }
+    auto matrix = std::make_shared<StrategyMatrix<double>>(matrixSize);
+    for (size_t r = 0; r < matrixSize; ++r) {
+        for (size_t c = 0; c < matrixSize; ++c) {
+            matrix->at(r, c) = cells[r * matrixSize + c];
+        }
+    }
+    checkpoint.fitnessMatrix = matrix;
+
+    checkpoint.historyPath = readString(in);
+    checkpoint.historyBytes = readValue<std::uint64_t>(in);
+    checkpoint.leaderboardMerged = readValue<std::uint8_t>(in) != 0;
+    checkpoint.leaderboardBefore = readString(in);
+    return checkpoint;
+}
+
+CheckpointWriter::CheckpointWriter(const std::string& path)
+    : path(path), worker(&CheckpointWriter::writerLoop, this) {
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    pendingChanged.notify_all();
+    worker.join();
+}
+
+void CheckpointWriter::submit(EvolutionCheckpoint checkpoint) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (writeError) {
+            std::rethrow_exception(writeError);
+        }
+        pending = std::move(checkpoint);
+    }
+    pendingChanged.notify_all();
+}
+
+void CheckpointWriter::finish() {
+    std::unique_lock<std::mutex> lock(mutex);
+    pendingChanged.wait(lock, [this] { return !pending && !writing; });
+    if (writeError) {
+        std::rethrow_exception(writeError);
+    }
+}
+
+void CheckpointWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        pendingChanged.wait(lock, [this] { return pending || stopping; });
+        if (!pending) {
+            return; // stopping with nothing left to write
+        }
+
+        EvolutionCheckpoint checkpoint = std::move(*pending);
+        pending.reset();
+        writing = true;
+        lock.unlock();
+
+        try {
+            Checkpoint::save(path, checkpoint);
+        }
+        catch (...) {
+            lock.lock();
+            writeError = std::current_exception();
+            writing = false;
+            pendingChanged.notify_all();
+            continue;
+        }
+
+        lock.lock();
+        writing = false;
+        pendingChanged.notify_all();
+    }
+}
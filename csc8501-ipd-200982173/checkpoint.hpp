@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <exception>
+#include "cli_parser.hpp"
+#include "strategy_matrix.hpp"
+#include "evolutionary_dynamics.hpp"
+
+// Snapshot of an evolutionary run taken after a completed generation.
+// Pairings are reseeded from --seed for every pair, so the only random state the run depends on
+// is already captured by the cached fitness matrix.
+struct EvolutionCheckpoint {
+    std::string optionsKey;  // options that must match for a resume to continue the same run
+    int generation = 0;      // last completed generation
+    DynamicsState dynamicsState;
+    std::shared_ptr<const StrategyMatrix<double>> fitnessMatrix;
+    std::string historyPath; // evolutionary results csv being streamed, empty for text output
+    std::uint64_t historyBytes = 0; // size of the history file when the snapshot was taken
+    bool leaderboardMerged = false; // the finished run's shares are already in the leaderboard
+    std::string leaderboardBefore;  // leaderboard contents before they were, so a resume can redo the merge
+};
+
+class Checkpoint {
+public:
+    static std::string optionsKey(const CommandOptions& options);
+    static void save(const std::string& path, const EvolutionCheckpoint& checkpoint);
+    static EvolutionCheckpoint load(const std::string& path);
+};
+
+// Writes snapshots on a background thread so the generation loop never waits on disk.
+// Only the newest snapshot matters, so one still waiting to be written is replaced by the next.
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(const std::string& path);
+    ~CheckpointWriter();
+
+    void submit(EvolutionCheckpoint checkpoint);
+    void finish(); // waits for the last snapshot and rethrows any write error
+
+private:
+    std::string path;
+    std::mutex mutex;
+    std::condition_variable pendingChanged;
+    std::optional<EvolutionCheckpoint> pending;
+    bool writing = false;
+    bool stopping = false;
+    std::exception_ptr writeError;
+    std::thread worker;
+
+    void writerLoop();
+};
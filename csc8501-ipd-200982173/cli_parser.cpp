@@ -2,6 +2,7 @@
 #include <sstream>
 #include <algorithm>
 #include <unordered_set>
+#include <thread>
 #include "cli_parser.hpp"
 
 CommandOptions CLIParser::parse(int argc, char* argv[]) {
@@ -14,8 +15,17 @@ CommandOptions CLIParser::parse(int argc, char* argv[]) {
 
     bool epsilonInput = false;
     bool seedInput = false;
+    bool dynamicsInput = false;
+    bool mutationInput = false;
+    bool responseRateInput = false;
+    bool intervalInput = false;
+    bool workerInput = false;
 
     const std::unordered_set<std::string> validStrategies = { "ALLD", "ALLC", "TFT", "GRIM", "PAVLOV", "RND", "CTFT", "PROBER", "TROJAN", "RIVAL" };
+    const std::unordered_set<std::string> validDynamics = { "discrete", "continuous", "mutator", "best-response" };
+
+    options.executable = argv[0];
+    options.arguments.assign(argv + 1, argv + argc);
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -116,6 +126,125 @@ CommandOptions CLIParser::parse(int argc, char* argv[]) {
             }
             options.scb = true;
         }
+        else if (arg == "--dynamics" && i + 1 < argc) {
+            options.dynamics = argv[++i];
+            std::transform(options.dynamics.begin(), options.dynamics.end(), options.dynamics.begin(), ::tolower);
+            dynamicsInput = true;
+
+            if (!validDynamics.count(options.dynamics)) {
+                throw std::invalid_argument("Error - Invalid --dynamics, 'discrete', 'continuous', 'mutator' or 'best-response' required.");
+            }
+        }
+        else if (arg == "--mutation" && i + 1 < argc) {
+            options.mutation = std::stod(argv[++i]);
+            mutationInput = true;
+
+            if (options.mutation < 0.0 || options.mutation > 1.0) {
+                throw std::invalid_argument("Error - --mutation must be between 0.0 and 1.0");
+            }
+        }
+        else if (arg == "--response-rate" && i + 1 < argc) {
+            options.responseRate = std::stod(argv[++i]);
+            responseRateInput = true;
+
+            if (options.responseRate <= 0.0 || options.responseRate > 1.0) {
+                throw std::invalid_argument("Error - --response-rate must be above 0.0 and at most 1.0");
+            }
+        }
+        else if (arg == "--checkpoint" && i + 1 < argc) {
+            options.checkpointPath = argv[++i];
+        }
+        else if (arg == "--checkpoint-every" && i + 1 < argc) {
+            options.checkpointInterval = std::stoi(argv[++i]);
+            intervalInput = true;
+
+            if (options.checkpointInterval <= 0) {
+                throw std::invalid_argument("Error - --checkpoint-every must be positive");
+            }
+        }
+        else if (arg == "--resume" && i + 1 < argc) {
+            options.resumePath = argv[++i];
+        }
+        else if (arg == "--shards" && i + 1 < argc) {
+            options.shardCount = std::stoi(argv[++i]);
+            if (options.shardCount <= 0) {
+                throw std::invalid_argument("Error - --shards must be positive");
+            }
+        }
+        else if (arg == "--shard" && i + 1 < argc) {
+            // Worker selection in the form index/count, e.g. 2/8
+            std::string shard = argv[++i];
+            size_t slash = shard.find('/');
+            if (slash == std::string::npos) {
+                throw std::invalid_argument("Error - --shard must be in the format index/count");
+            }
+            options.shardIndex = std::stoi(shard.substr(0, slash));
+            options.shardCount = std::stoi(shard.substr(slash + 1));
+            workerInput = true;
+
+            if (options.shardCount <= 0 || options.shardIndex < 0 || options.shardIndex >= options.shardCount) {
+                throw std::invalid_argument("Error - --shard index must be between 0 and count - 1");
+            }
+        }
+        else if (arg == "--shard-dir" && i + 1 < argc) {
+            options.shardDirectory = argv[++i];
+        }
+        else if (arg == "--serve" && i + 1 < argc) {
+            options.servePath = argv[++i];
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = std::stoi(argv[++i]);
+            if (options.threads <= 0) {
+                throw std::invalid_argument("Error - --threads must be positive");
+            }
+        }
+        else if (arg == "--cache-size" && i + 1 < argc) {
+            int size = std::stoi(argv[++i]);
+            if (size < 0) {
+                throw std::invalid_argument("Error - --cache-size must not be negative");
+            }
+            options.cacheSize = size;
+        }
+        else if (arg == "--max-memory" && i + 1 < argc) {
+            // Budget in MiB
+            int megabytes = std::stoi(argv[++i]);
+            if (megabytes <= 0) {
+                throw std::invalid_argument("Error - --max-memory must be a positive number of MiB");
+            }
+            options.maxMemory = static_cast<std::uint64_t>(megabytes);
+        }
+        else if (arg == "--verify" && i + 1 < argc) {
+            options.verifyCount = std::stoi(argv[++i]);
+            if (options.verifyCount <= 0) {
+                throw std::invalid_argument("Error - --verify must be a positive number of configurations");
+            }
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+            // Match key in the form S1,S2,repetition, e.g. TFT,RND0.5,3
+            std::string key = argv[++i];
+            std::transform(key.begin(), key.end(), key.begin(), ::toupper);
+            std::stringstream keyStream(key);
+            std::string strat1;
+            std::string strat2;
+            std::string repetition;
+            if (!std::getline(keyStream, strat1, ',') || !std::getline(keyStream, strat2, ',') || !std::getline(keyStream, repetition)) {
+                throw std::invalid_argument("Error - --replay must be in the format S1,S2,repetition");
+            }
+            for (const auto& strategy : { strat1, strat2 }) {
+                if (!validStrategies.count(strategy) && strategy.substr(0, 3) != "RND") {
+                    throw std::invalid_argument("Error - Invalid strategy: " + strategy);
+                }
+            }
+            options.replayStrategies = { strat1, strat2 };
+            options.replayRepeat = std::stoi(repetition);
+        }
+        else if (arg == "--metrics" && i + 1 < argc) {
+            int val = std::stoi(argv[++i]);
+            if (val != 1) {
+                throw std::invalid_argument("Error - --metrics must be 1 to collect per-round metrics");
+            }
+            options.metrics = true;
+        }
         else if (arg == "--format" && i + 1 < argc) {
             options.format = argv[++i];
             std::transform(options.format.begin(), options.format.end(), options.format.begin(), ::tolower);
@@ -125,6 +254,26 @@ CommandOptions CLIParser::parse(int argc, char* argv[]) {
         }
     }
 
+    if (options.threads == 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Server mode takes its tournament settings from each request instead, and --verify makes up its own
+    if (!options.servePath.empty() || options.verifyCount > 0) {
+        return options;
+    }
+
+    // A replay always prints its rounds. Without --strategies the pair is seated as given; with the
+    // tournament's --strategies it is seated as the tournament seated it.
+    if (options.replayRepeat != 0) {
+        if (options.format.empty()) {
+            options.format = "text";
+        }
+        if (options.strategies.empty()) {
+            options.strategies = options.replayStrategies;
+        }
+    }
+
     if (options.format.empty()) {
         throw std::invalid_argument("Error - --format argument is required (text or csv).");
     }
@@ -183,6 +332,65 @@ CommandOptions CLIParser::parse(int argc, char* argv[]) {
     if (options.scb && !options.evolve) {
         throw std::invalid_argument("Error - --scb can only be used with --evolve.");
     }
+
+    if (dynamicsInput && !options.evolve) {
+        throw std::invalid_argument("Error - --dynamics can only be used with --evolve.");
+    }
+
+    if (mutationInput && options.dynamics != "mutator") {
+        throw std::invalid_argument("Error - --mutation can only be used with --dynamics mutator.");
+    }
+
+    if (responseRateInput && options.dynamics != "best-response") {
+        throw std::invalid_argument("Error - --response-rate can only be used with --dynamics best-response.");
+    }
+
+    if ((!options.checkpointPath.empty() || !options.resumePath.empty()) && !options.evolve) {
+        throw std::invalid_argument("Error - --checkpoint and --resume can only be used with --evolve.");
+    }
+
+    if (intervalInput && options.checkpointPath.empty()) {
+        throw std::invalid_argument("Error - --checkpoint-every requires --checkpoint.");
+    }
+
+    if (options.shardCount > 0) {
+        if (options.evolve) {
+            throw std::invalid_argument("Error - --shards can not be used with --evolve.");
+        }
+        if (options.format != "csv") {
+            throw std::invalid_argument("Error - --shards requires --format csv.");
+        }
+    }
+
+    if (options.replayRepeat != 0) {
+        for (const auto& strategy : options.replayStrategies) {
+            if (std::find(options.strategies.begin(), options.strategies.end(), strategy) == options.strategies.end()) {
+                throw std::invalid_argument("Error - --replay strategy " + strategy + " is not in --strategies");
+            }
+        }
+        if (options.replayRepeat < 1 || options.replayRepeat > options.repeats) {
+            throw std::invalid_argument("Error - --replay repetition must be between 1 and --repeats");
+        }
+        if (options.evolve || options.shardCount > 0) {
+            throw std::invalid_argument("Error - --replay can not be used with --evolve or --shards.");
+        }
+    }
+
+    if (options.metrics) {
+        if (options.evolve) {
+            throw std::invalid_argument("Error - --metrics can not be used with --evolve.");
+        }
+        if (options.format != "csv") {
+            throw std::invalid_argument("Error - --metrics requires --format csv.");
+        }
+        if (options.shardCount > 0) {
+            throw std::invalid_argument("Error - --metrics can not be used with --shards.");
+        }
+    }
+
+    if (workerInput && options.shardDirectory.empty()) {
+        throw std::invalid_argument("Error - --shard requires --shard-dir.");
+    }
     
     return options;
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <stdexcept>
@@ -18,6 +19,25 @@ struct CommandOptions {
     int population = 0;
     int generations = 0;
     bool scb = false; // Strategic Complexity Budget (SCB)
+    std::string dynamics = "discrete"; // Evolutionary dynamics: discrete, continuous, mutator or best-response
+    double mutation = 0.0; // Mutation rate for replicator-mutator dynamics
+    double responseRate = 0.1; // Share of the population switching to the best response each generation
+    std::string checkpointPath; // Evolutionary snapshot file, empty = no checkpointing
+    int checkpointInterval = 100; // Generations between snapshots
+    std::string resumePath; // Snapshot to continue from
+    int shardCount = 0; // Number of worker processes the tournament is split across, 0 = run in process
+    int shardIndex = -1; // Shard this process computes when running as a worker, -1 = coordinator
+    std::string shardDirectory; // Where workers write their partial results
+    std::string servePath; // Unix socket the simulation server listens on, empty = run once
+    int threads = 0; // Worker threads, 0 = one per hardware thread
+    size_t cacheSize = 100000; // Pairing results kept by the simulation server
+    std::uint64_t maxMemory = 0; // Resident memory budget in MiB, 0 = unlimited
+    int verifyCount = 0; // Random configurations checked by --verify, 0 = normal run
+    int replayRepeat = 0; // Repetition replayed by --replay, counted from 1, 0 = normal run
+    std::vector<std::string> replayStrategies; // Pairing replayed by --replay, in the seat order it is printed
+    bool metrics = false; // Collect per-round metrics (cooperation rate, first defection, retaliation, lock-in)
+    std::string executable; // argv[0], used to start worker processes
+    std::vector<std::string> arguments; // Original command line, passed on to workers
     std::string format;
 };
 
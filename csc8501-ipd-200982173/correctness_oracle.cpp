@@ -0,0 +1,472 @@
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include "correctness_oracle.hpp"
+#include "game_manager.hpp"
+#include "strategy_creator.hpp"
+#include "tournament_manager.hpp"
+#include "evolutionary_dynamics.hpp"
+#include "random_stream.hpp"
+
+namespace {
+    struct ReferenceGame {
+        std::vector<char> moves;
+        double p1Score;
+        double p2Score;
+    };
+
+    // Mean and sample standard deviation, computed directly rather than with ScoreAccumulator
+    struct ReferenceStatistics {
+        double p1Mean = 0.0;
+        double p2Mean = 0.0;
+        double p1Stdev = 0.0;
+        double p2Stdev = 0.0;
+    };
+
+    // One repeat played with the seeding the tournament documents: noise from (seed, repeat),
+    // strategy randomness from (seed, repeat, seat)
+    ReferenceGame playReference(const CommandOptions& config, const Payoff<double>& payoff, const std::string& strat1, const std::string& strat2, int repeat) {
+        RandomStream randNumGen(config.seed, repeat, RandomStream::noiseSeat);
+
+        GameManager<double> game(StrategyCreator::createSeededStrategy(strat1, config.seed, repeat, 1),
+            StrategyCreator::createSeededStrategy(strat2, config.seed, repeat, 2),
+            payoff, config.epsilon, randNumGen, config.noiseOn, "csv");
+
+        RoundMetrics<MoveHistory> history;
+        game.runGame(config.rounds, repeat + 1, config.repeats, history);
+        return { history.getMoves(), game.getPlayer1Strategy()->getScore(), game.getPlayer2Strategy()->getScore() };
+    }
+
+    ReferenceStatistics referenceStatistics(const std::vector<ReferenceGame>& games) {
+        ReferenceStatistics stats;
+        double n = static_cast<double>(games.size());
+        for (const auto& game : games) {
+            stats.p1Mean += game.p1Score / n;
+            stats.p2Mean += game.p2Score / n;
+        }
+        if (games.size() > 1) {
+            double p1Squares = 0.0;
+            double p2Squares = 0.0;
+            for (const auto& game : games) {
+                p1Squares += (game.p1Score - stats.p1Mean) * (game.p1Score - stats.p1Mean);
+                p2Squares += (game.p2Score - stats.p2Mean) * (game.p2Score - stats.p2Mean);
+            }
+            stats.p1Stdev = std::sqrt(p1Squares / (n - 1));
+            stats.p2Stdev = std::sqrt(p2Squares / (n - 1));
+        }
+        return stats;
+    }
+
+    std::vector<char> swapSeats(const std::vector<char>& moves) {
+        std::vector<char> swapped;
+        for (char move : moves) {
+            swapped.push_back(static_cast<char>(((move & 1) << 1) | (move >> 1)));
+        }
+        return swapped;
+    }
+
+    bool agrees(double a, double b, double relative) {
+        return std::abs(a - b) <= relative * std::max(1.0, std::abs(b));
+    }
+
+    // Feeds a recorded game through a collector, as GameManager would have while playing it
+    void collectGame(TournamentMetrics& metrics, const std::vector<char>& moves) {
+        metrics.beginGame(static_cast<int>(moves.size()));
+        for (size_t round = 0; round < moves.size(); ++round) {
+            metrics.recordRound(static_cast<int>(round) + 1, moves[round] & 1, moves[round] >> 1);
+        }
+        metrics.endGame();
+    }
+
+    // Compares the csv values field by field, and the cooperation series round by round
+    bool metricsAgree(const TournamentMetrics& a, const TournamentMetrics& b, double relative) {
+        if (a.getGames() != b.getGames() || a.getRounds() != b.getRounds()) {
+            return false;
+        }
+        for (size_t round = 1; round <= a.getRounds(); ++round) {
+            if (a.getP1Rate(static_cast<int>(round)) != b.getP1Rate(static_cast<int>(round))
+                || a.getP2Rate(static_cast<int>(round)) != b.getP2Rate(static_cast<int>(round))) {
+                return false;
+            }
+        }
+
+        std::ostringstream aValues;
+        std::ostringstream bValues;
+        aValues.precision(17);
+        bValues.precision(17);
+        a.writeValues(aValues);
+        b.writeValues(bValues);
+        std::stringstream aStream(aValues.str());
+        std::stringstream bStream(bValues.str());
+        std::string aField;
+        std::string bField;
+        while (std::getline(aStream, aField, ',')) {
+            if (!std::getline(bStream, bField, ',')) {
+                return false;
+            }
+            // Text such as N/A must match exactly, numbers to within rounding
+            char* aEnd = nullptr;
+            char* bEnd = nullptr;
+            double aValue = std::strtod(aField.c_str(), &aEnd);
+            double bValue = std::strtod(bField.c_str(), &bEnd);
+            bool numbers = !aField.empty() && !bField.empty() && *aEnd == '\0' && *bEnd == '\0';
+            if (numbers ? !agrees(aValue, bValue, relative) : aField != bField) {
+                return false;
+            }
+        }
+        return !std::getline(bStream, bField, ',');
+    }
+
+    // Engine output is not part of the check, so it is silenced while the engine runs
+    class SilenceOutput {
+    public:
+        SilenceOutput() : previous(std::cout.rdbuf(nullptr)) {}
+        ~SilenceOutput() {
+            std::cout.rdbuf(previous);
+            std::cout.clear(); // writing to a null buffer sets badbit
+        }
+    private:
+        std::streambuf* previous;
+    };
+
+    constexpr double meanTolerance = 1e-9;
+    constexpr double stdevTolerance = 1e-6;
+    constexpr double samplingSigmas = 6.0;
+    constexpr int minStatisticalRepeats = 10;
+    constexpr double metricsTolerance = 1e-9;
+    constexpr double kernelTolerance = 1e-12;
+    constexpr size_t maxKernelSize = 13; // several four-row blocks of the multiply plus every remainder
+}
+
+CorrectnessOracle::CorrectnessOracle(const CommandOptions& options)
+    : options(options), randNumGen(static_cast<std::mt19937::result_type>(options.seed)) {
+}
+
+void CorrectnessOracle::run() {
+    std::cout << "=====VERIFYING ENGINE=====: " << options.verifyCount << " random configurations | seed: " << options.seed << "\n";
+
+    for (int i = 0; i < options.verifyCount; ++i) {
+        std::vector<std::string> args = randomArguments();
+
+        std::ostringstream description;
+        for (size_t a = 1; a < args.size(); ++a) {
+            description << (a == 1 ? "" : " ") << args[a];
+        }
+
+        std::vector<char*> argv;
+        for (auto& arg : args) {
+            argv.push_back(arg.data());
+        }
+        CommandOptions config = CLIParser::parse(static_cast<int>(argv.size()), argv.data());
+        verifyConfiguration(config, description.str());
+        verifyDynamics(i);
+    }
+
+    if (!failures.empty()) {
+        for (const auto& failure : failures) {
+            std::cout << failure << "\n";
+        }
+        throw std::runtime_error("Error - " + std::to_string(failures.size()) + " of " + std::to_string(checks) + " verification checks failed");
+    }
+    std::cout << "- All " << checks << " checks passed\n";
+}
+
+// A valid command line for a random pairing, payoff, noise level and seed
+std::vector<std::string> CorrectnessOracle::randomArguments() {
+    const std::vector<std::string> pool = { "ALLC", "ALLD", "TFT", "GRIM", "PAVLOV", "CTFT", "PROBER", "TROJAN", "RIVAL", "RND" };
+    auto pick = [&](int low, int high) {
+        return std::uniform_int_distribution<int>(low, high)(randNumGen);
+    };
+
+    std::vector<std::string> strategies;
+    int minRounds = 1;
+    for (int seat = 0; seat < 2; ++seat) {
+        std::string name = pool[pick(0, static_cast<int>(pool.size()) - 1)];
+        if (name == "RND") {
+            name += "0." + std::to_string(pick(1, 9));
+        }
+        minRounds = std::max(minRounds, name == "TROJAN" ? 10 : name == "PROBER" ? 5 : 1);
+        strategies.push_back(name);
+    }
+
+    // Payoffs in tenths, with T > R > P > S and 2R > T + S
+    int s = pick(0, 10);
+    int p = s + pick(1, 20);
+    int r = p + pick(1, 20);
+    int t = r + pick(1, r - s - 1);
+    auto tenths = [](int value) {
+        std::ostringstream text;
+        text << value / 10 << "." << value % 10;
+        return text.str();
+    };
+
+    std::vector<std::string> args = { options.executable,
+        "--rounds", std::to_string(pick(minRounds, 150)),
+        "--repeats", std::to_string(pick(1, 30)),
+        "--strategies", strategies[0] + "," + strategies[1],
+        "--payoff", tenths(t) + "," + tenths(r) + "," + tenths(p) + "," + tenths(s),
+        "--format", "csv" };
+
+    if (pick(0, 1) == 1) {
+        args.insert(args.end(), { "--epsilon", "0." + std::to_string(pick(0, 300) + 1000).substr(1), "--seed", std::to_string(pick(0, 1000000)) });
+    }
+    return args;
+}
+
+void CorrectnessOracle::verifyConfiguration(const CommandOptions& config, const std::string& description) {
+    Payoff<double> payoff(config.t, config.r, config.p, config.s);
+    StrategyRegistry registry(config.strategies);
+    size_t n = registry.size();
+
+    // Reference games for every ordered pairing, the mirrored ones played for real
+    StrategyMatrix<std::vector<ReferenceGame>> reference(n);
+    StrategyMatrix<ReferenceStatistics> referenceStats(n);
+    for (StrategyId a = 0; a < n; ++a) {
+        for (StrategyId b = 0; b < n; ++b) {
+            const std::string& strat1 = registry.getName(a);
+            const std::string& strat2 = registry.getName(b);
+            std::string pairing = " (" + strat1 + " vs " + strat2 + ")";
+
+            auto& games = reference.at(a, b);
+            for (int repeat = 0; repeat < config.repeats; ++repeat) {
+                games.push_back(playReference(config, payoff, strat1, strat2, repeat));
+
+                // Scores must follow from the moves
+                double p1Score = 0.0;
+                double p2Score = 0.0;
+                for (char move : games.back().moves) {
+                    p1Score += payoff.calculatePayoff(move & 1, move >> 1);
+                    p2Score += payoff.calculatePayoff(move >> 1, move & 1);
+                }
+                check(p1Score == games.back().p1Score && p2Score == games.back().p2Score, description,
+                    "scores do not match the moves in repetition " + std::to_string(repeat + 1) + pairing);
+            }
+
+            // Replaying a repetition from its key reproduces it exactly
+            for (int repeat : { 0, config.repeats - 1 }) {
+                ReferenceGame replay = playReference(config, payoff, strat1, strat2, repeat);
+                check(replay.moves == games[repeat].moves && replay.p1Score == games[repeat].p1Score && replay.p2Score == games[repeat].p2Score,
+                    description, "replay of repetition " + std::to_string(repeat + 1) + " differs" + pairing);
+            }
+
+            // Deterministic strategies without noise must repeat the same game, which the engine relies on
+            bool deterministic = !config.noiseOn && StrategyCreator::createStrategy(strat1)->isDeterministic() && StrategyCreator::createStrategy(strat2)->isDeterministic();
+            if (deterministic) {
+                for (const auto& game : games) {
+                    check(game.moves == games[0].moves, description, "deterministic repetitions differ" + pairing);
+                }
+            }
+
+            referenceStats.at(a, b) = referenceStatistics(games);
+        }
+    }
+
+    // Mirrored deterministic pairings must be the same games with the seats swapped
+    for (StrategyId a = 0; a < n; ++a) {
+        for (StrategyId b = a + 1; b < n; ++b) {
+            bool deterministic = !config.noiseOn && StrategyCreator::createStrategy(registry.getName(a))->isDeterministic() && StrategyCreator::createStrategy(registry.getName(b))->isDeterministic();
+            if (deterministic) {
+                check(swapSeats(reference.at(a, b)[0].moves) == reference.at(b, a)[0].moves, description,
+                    "mirrored games differ (" + registry.getName(a) + " vs " + registry.getName(b) + ")");
+            }
+        }
+    }
+
+    // The engine on one thread, on several threads with repeats split into blocks, and through the cache
+    auto compareEngine = [&](const StrategyMatrix<MatchStatistics>& results, const std::string& engine) {
+        for (StrategyId a = 0; a < n; ++a) {
+            for (StrategyId b = 0; b < n; ++b) {
+                const MatchStatistics& stats = results.at(a, b);
+                std::string pairing = " (" + engine + ", " + registry.getName(a) + " vs " + registry.getName(b) + ")";
+
+                // Pairings the engine plays as seated, or mirrors from the pairing it did play
+                const ReferenceStatistics& played = a <= b ? referenceStats.at(a, b) : referenceStats.at(b, a);
+                double p1Mean = a <= b ? played.p1Mean : played.p2Mean;
+                double p2Mean = a <= b ? played.p2Mean : played.p1Mean;
+                double p1Stdev = a <= b ? played.p1Stdev : played.p2Stdev;
+                double p2Stdev = a <= b ? played.p2Stdev : played.p1Stdev;
+                check(agrees(stats.p1Mean, p1Mean, meanTolerance) && agrees(stats.p2Mean, p2Mean, meanTolerance), description, "means differ from the reference" + pairing);
+                check(agrees(stats.p1Stdev, p1Stdev, stdevTolerance) && agrees(stats.p2Stdev, p2Stdev, stdevTolerance), description, "standard deviations differ from the reference" + pairing);
+
+                // A mirrored pairing with randomness is a different sample of the same match
+                if (a > b && config.repeats >= minStatisticalRepeats) {
+                    const ReferenceStatistics& seated = referenceStats.at(a, b);
+                    double p1Error = std::sqrt((stats.p1Stdev * stats.p1Stdev + seated.p1Stdev * seated.p1Stdev) / config.repeats);
+                    double p2Error = std::sqrt((stats.p2Stdev * stats.p2Stdev + seated.p2Stdev * seated.p2Stdev) / config.repeats);
+                    check(std::abs(stats.p1Mean - seated.p1Mean) <= samplingSigmas * p1Error + meanTolerance
+                        && std::abs(stats.p2Mean - seated.p2Mean) <= samplingSigmas * p2Error + meanTolerance,
+                        description, "mirrored means are outside sampling error of the seated reference" + pairing);
+                }
+            }
+        }
+    };
+
+    for (int threads : { 1, 3 }) {
+        CommandOptions engineOptions = config;
+        engineOptions.threads = threads;
+        TournamentManager<double> tournament(engineOptions, payoff);
+
+        SilenceOutput silence;
+        auto results = tournament.playRoundRobin(registry);
+        compareEngine(results, std::to_string(threads) + " thread" + (threads == 1 ? "" : "s"));
+    }
+
+    PairResultCache cache(64);
+    TournamentManager<double> cached(config, payoff);
+    cached.setPairCache(&cache);
+    {
+        SilenceOutput silence;
+        cached.playRoundRobin(registry);
+        compareEngine(cached.playRoundRobin(registry), "cached");
+    }
+    check(cache.getHits() > 0, description, "second cached run did not use the cache");
+
+    // Shards written the way --shard workers write them, then read back and merged by the coordinator
+    int shardCount = std::uniform_int_distribution<int>(2, 4)(randNumGen);
+    std::filesystem::path shardDirectory = std::filesystem::temp_directory_path() / ("ipd-verify-" + std::to_string(randNumGen()));
+    std::filesystem::create_directories(shardDirectory);
+    {
+        CommandOptions shardOptions = config;
+        shardOptions.shardCount = shardCount;
+        shardOptions.shardDirectory = shardDirectory.string();
+        TournamentManager<double> worker(shardOptions, payoff);
+        for (int shard = 0; shard < shardCount; ++shard) {
+            Sharding::writeShard(Sharding::shardFilename(shardOptions.shardDirectory, shard, shardCount), Sharding::optionsKey(shardOptions), worker.playShard(registry, shard, shardCount));
+        }
+
+        TournamentManager<double> coordinator(shardOptions, payoff);
+        SilenceOutput silence;
+        compareEngine(coordinator.playRoundRobin(registry), std::to_string(shardCount) + " shards");
+    }
+    std::filesystem::remove_all(shardDirectory);
+
+    // Per-round metrics: reference games collected directly, the reverse seatings from the
+    // seat-swapped games of the pairing that was played
+    StrategyMatrix<TournamentMetrics> referenceMetrics(n);
+    for (StrategyId a = 0; a < n; ++a) {
+        for (StrategyId b = 0; b < n; ++b) {
+            for (const auto& game : a <= b ? reference.at(a, b) : reference.at(b, a)) {
+                collectGame(referenceMetrics.at(a, b), a <= b ? game.moves : swapSeats(game.moves));
+            }
+        }
+    }
+
+    // Merging the collectors of two blocks of repeats equals collecting every repeat in one
+    for (StrategyId a = 0; a < n; ++a) {
+        for (StrategyId b = a; b < n; ++b) {
+            const auto& games = reference.at(a, b);
+            size_t split = std::uniform_int_distribution<size_t>(0, games.size())(randNumGen);
+            TournamentMetrics first;
+            TournamentMetrics second;
+            for (size_t g = 0; g < games.size(); ++g) {
+                collectGame(g < split ? first : second, games[g].moves);
+            }
+            first.merge(second);
+            check(metricsAgree(first, referenceMetrics.at(a, b), metricsTolerance), description,
+                "merged metrics differ (" + registry.getName(a) + " vs " + registry.getName(b) + ", split after " + std::to_string(split) + ")");
+        }
+    }
+
+    for (int threads : { 1, 3 }) {
+        CommandOptions engineOptions = config;
+        engineOptions.threads = threads;
+        TournamentManager<double> tournament(engineOptions, payoff);
+        StrategyMatrix<TournamentMetrics> metrics(n);
+        {
+            SilenceOutput silence;
+            tournament.playRoundRobin(registry, &metrics);
+        }
+        for (StrategyId a = 0; a < n; ++a) {
+            for (StrategyId b = 0; b < n; ++b) {
+                check(metricsAgree(metrics.at(a, b), referenceMetrics.at(a, b), metricsTolerance), description,
+                    std::string(a <= b ? "" : "mirrored ") + "metrics differ from the reference (" + std::to_string(threads) + " thread"
+                    + (threads == 1 ? "" : "s") + ", " + registry.getName(a) + " vs " + registry.getName(b) + ")");
+            }
+        }
+    }
+}
+
+// StrategyMatrix::multiply and one step of each kind of dynamics against plain loops, on a random
+// matrix of 1 to 13 strategies so every remainder of the multiply's four-row blocks comes up
+void CorrectnessOracle::verifyDynamics(int configuration) {
+    size_t n = std::uniform_int_distribution<size_t>(1, maxKernelSize)(randNumGen);
+    std::uniform_real_distribution<double> payoffDistribution(0.0, 5.0);
+    std::uniform_real_distribution<double> shareDistribution(0.01, 1.0);
+    std::string description = "dynamics check " + std::to_string(configuration + 1) + " on " + std::to_string(n) + " strategies (--verify with --seed " + std::to_string(options.seed) + ")";
+
+    StrategyMatrix<double> matrix(n);
+    std::vector<double> shares(n);
+    double total = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            matrix.at(i, j) = payoffDistribution(randNumGen);
+        }
+        shares[i] = shareDistribution(randNumGen);
+        total += shares[i];
+    }
+    for (double& share : shares) {
+        share /= total;
+    }
+
+    std::vector<double> fitness(n, 0.0);
+    double meanFitness = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            fitness[i] += matrix.at(i, j) * shares[j];
+        }
+        meanFitness += shares[i] * fitness[i];
+    }
+
+    std::vector<double> product;
+    matrix.multiply(shares, product);
+    bool productAgrees = product.size() == n;
+    for (size_t i = 0; productAgrees && i < n; ++i) {
+        productAgrees = agrees(product[i], fitness[i], kernelTolerance);
+    }
+    check(productAgrees, description, "matrix-vector product differs from the plain loop");
+
+    std::vector<double> replicator(n);
+    for (size_t i = 0; i < n; ++i) {
+        replicator[i] = shares[i] * fitness[i] / meanFitness;
+    }
+
+    double mutationRate = std::uniform_real_distribution<double>(0.0, 0.2)(randNumGen);
+    std::vector<double> mutated = replicator;
+    if (n > 1) {
+        for (size_t i = 0; i < n; ++i) {
+            mutated[i] = (1.0 - mutationRate) * replicator[i] + mutationRate / (n - 1) * (1.0 - replicator[i]);
+        }
+    }
+
+    double responseRate = std::uniform_real_distribution<double>(0.01, 1.0)(randNumGen);
+    size_t best = std::max_element(fitness.begin(), fitness.end()) - fitness.begin();
+    std::vector<double> responded(n);
+    for (size_t i = 0; i < n; ++i) {
+        responded[i] = shares[i] * (1.0 - responseRate) + (i == best ? responseRate : 0.0);
+    }
+
+    auto compareStep = [&](DynamicsType type, const std::vector<double>& expected, const std::string& name) {
+        EvolutionaryDynamics dynamics(matrix, type, mutationRate, responseRate);
+        dynamics.setShares(shares);
+        dynamics.step();
+        bool stepAgrees = true;
+        for (size_t i = 0; i < n; ++i) {
+            stepAgrees = stepAgrees && agrees(dynamics.getShares()[i], expected[i], kernelTolerance);
+        }
+        check(stepAgrees, description, name + " step differs from the plain update");
+    };
+    compareStep(DynamicsType::Discrete, replicator, "replicator");
+    compareStep(DynamicsType::Mutator, mutated, "mutator (mutation " + std::to_string(mutationRate) + ")");
+    compareStep(DynamicsType::BestResponse, responded, "best-response (rate " + std::to_string(responseRate) + ")");
+}
+
+void CorrectnessOracle::check(bool passed, const std::string& description, const std::string& what) {
+    checks++;
+    if (!passed) {
+        failures.push_back("FAILED: " + what + "\n  " + description);
+    }
+}
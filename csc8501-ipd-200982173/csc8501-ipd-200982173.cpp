@@ -2,19 +2,42 @@
 #include "cli_parser.hpp"
 #include "tournament_manager.hpp"
 #include "payoff.hpp"
+#include "simulation_server.hpp"
+#include "memory_budget.hpp"
+#include "correctness_oracle.hpp"
 
 int main(int argc, char* argv[]) {
     try {
         CommandOptions options = CLIParser::parse(argc, argv);
+
+        if (!options.servePath.empty()) {
+            SimulationServer server(options);
+            server.run();
+            return 0;
+        }
+
+        if (options.verifyCount > 0) {
+            CorrectnessOracle oracle(options);
+            oracle.run();
+            return 0;
+        }
+
         Payoff<double> payoff(options.t, options.r, options.p, options.s);
         TournamentManager<double> tournament(options, payoff);
         
-        if (options.evolve) {
+        if (options.replayRepeat > 0) {
+            tournament.replayMatch(options.replayRepeat);
+        }
+        else if (options.evolve) {
             tournament.runEvolutionaryTournament();
         }
         else {
             tournament.runTournament();
         }
+
+        if (options.maxMemory > 0) {
+            MemoryBudget(options.maxMemory).reportPeak();
+        }
     }
     catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
@@ -35,7 +35,7 @@ Action CTFT::decideAction(const GameState& state) {
     return nextAction;
 }
 
-std::string CTFT::name() const {
+std::string_view CTFT::name() const {
     return "CTFT";
 }
 
@@ -5,7 +5,8 @@ class CTFT : public Strategy {
 public:
     
     Action decideAction(const GameState& state) override;
-    std::string name() const override;
+    std::string_view name() const override;
+    bool isDeterministic() const override { return true; }
     bool isContrite() const { return contrite; }
     void setLastMoves(Action intended, Action actual);
     
@@ -0,0 +1,255 @@
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "evolutionary_dynamics.hpp"
+
+EvolutionaryDynamics::EvolutionaryDynamics(const StrategyMatrix<double>& fitnessMatrix, DynamicsType type, double mutationRate, double responseRate)
+    : fitnessMatrix(fitnessMatrix), type(type), mutationRate(mutationRate), responseRate(responseRate),
+    shares(fitnessMatrix.size(), 1.0 / fitnessMatrix.size()) {
+}
+
+DynamicsType EvolutionaryDynamics::parseType(const std::string& name) {
+    if (name == "discrete") {
+        return DynamicsType::Discrete;
+    }
+    if (name == "continuous") {
+        return DynamicsType::Continuous;
+    }
+    if (name == "mutator") {
+        return DynamicsType::Mutator;
+    }
+    if (name == "best-response") {
+        return DynamicsType::BestResponse;
+    }
+    throw std::invalid_argument("Error - Invalid --dynamics, 'discrete', 'continuous', 'mutator' or 'best-response' required.");
+}
+
+void EvolutionaryDynamics::setShares(const std::vector<double>& newShares) {
+    shares = newShares;
+    normalise(shares);
+    recentShares.clear();
+    cycleLength = 0;
+}
+
+DynamicsState EvolutionaryDynamics::saveState() const {
+    return { shares, std::vector<std::vector<double>>(recentShares.begin(), recentShares.end()), cycleLength, stepSize };
+}
+
+void EvolutionaryDynamics::restoreState(const DynamicsState& state) {
+    if (state.shares.size() != shares.size()) {
+        throw std::invalid_argument("Error - saved population does not match the number of strategies");
+    }
+    shares = state.shares;
+    recentShares.assign(state.recentShares.begin(), state.recentShares.end());
+    cycleLength = state.cycleLength;
+    stepSize = state.stepSize;
+}
+
+void EvolutionaryDynamics::step() {
+    switch (type) {
+    case DynamicsType::Discrete:
+        discreteStep();
+        break;
+    case DynamicsType::Continuous:
+        continuousStep();
+        break;
+    case DynamicsType::Mutator:
+        mutatorStep();
+        break;
+    case DynamicsType::BestResponse:
+        bestResponseStep();
+        break;
+    }
+    detectConvergence();
+}
+
+// x_i' = x_i * f_i / (x . f)
+void EvolutionaryDynamics::discreteStep() {
+    fitnessMatrix.multiply(shares, fitness);
+
+    double totalFitnessWeight = 0.0;
+    for (size_t i = 0; i < shares.size(); ++i) {
+        totalFitnessWeight += shares[i] * fitness[i];
+    }
+
+    for (size_t i = 0; i < shares.size(); ++i) {
+        shares[i] = (shares[i] * fitness[i]) / totalFitnessWeight;
+    }
+}
+
+// dx_i/dt = x_i * (f_i - x . f)
+void EvolutionaryDynamics::replicatorDerivative(const std::vector<double>& x, std::vector<double>& dxdt) {
+    fitnessMatrix.multiply(x, fitness);
+
+    double averageFitness = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        averageFitness += x[i] * fitness[i];
+    }
+
+    dxdt.resize(x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        dxdt[i] = x[i] * (fitness[i] - averageFitness);
+    }
+}
+
+void EvolutionaryDynamics::rungeKuttaStep(const std::vector<double>& x, double h, std::vector<double>& out) {
+    size_t n = x.size();
+    temp.resize(n);
+
+    replicatorDerivative(x, k1);
+    for (size_t i = 0; i < n; ++i) {
+        temp[i] = x[i] + 0.5 * h * k1[i];
+    }
+    replicatorDerivative(temp, k2);
+    for (size_t i = 0; i < n; ++i) {
+        temp[i] = x[i] + 0.5 * h * k2[i];
+    }
+    replicatorDerivative(temp, k3);
+    for (size_t i = 0; i < n; ++i) {
+        temp[i] = x[i] + h * k3[i];
+    }
+    replicatorDerivative(temp, k4);
+
+    out.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = x[i] + (h / 6.0) * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
+    }
+}
+
+// Integrates one unit of time. The step size is chosen by step doubling: a full RK4 step is
+// compared against two half steps and the step is only accepted when every share agrees within
+// its tolerance, which is relative to the share's size so small and large shares are held to the
+// same number of significant digits.
+void EvolutionaryDynamics::continuousStep() {
+    double remaining = 1.0;
+
+    while (remaining > 0.0) {
+        double h = std::min(stepSize, remaining);
+        bool truncated = h < stepSize;
+
+        rungeKuttaStep(shares, h, full);
+        rungeKuttaStep(shares, 0.5 * h, half);
+        rungeKuttaStep(half, 0.5 * h, twoHalves);
+
+        // Largest error as a multiple of its share's tolerance, so 1 is exactly on the limit
+        double error = 0.0;
+        for (size_t i = 0; i < shares.size(); ++i) {
+            double tolerance = odeAbsoluteTolerance + odeRelativeTolerance * std::max(std::abs(shares[i]), std::abs(twoHalves[i]));
+            error = std::max(error, std::abs(twoHalves[i] - full[i]) / tolerance);
+        }
+
+        bool accepted = error <= 1.0 || h < 1e-12;
+        if (accepted) {
+            std::swap(shares, twoHalves);
+            normalise(shares);
+            remaining -= h;
+        }
+
+        // A step cut short to end the generation says nothing about the step size the error
+        // allows, so it is kept for the next generation rather than shrunk to the remainder
+        if (truncated && accepted) {
+            continue;
+        }
+
+        // RK4 local error scales with h^5
+        double scale = (error > 0.0) ? 0.9 * std::pow(1.0 / error, 0.2) : 2.0;
+        stepSize = h * std::clamp(scale, 0.2, 2.0);
+    }
+}
+
+// Replicator selection followed by uniform mutation: each offspring keeps its parent's strategy
+// with probability 1 - mu, otherwise switches to one of the other n - 1 strategies
+void EvolutionaryDynamics::mutatorStep() {
+    discreteStep();
+
+    size_t n = shares.size();
+    if (n < 2) {
+        return;
+    }
+    double spread = mutationRate / (n - 1);
+    for (size_t i = 0; i < n; ++i) {
+        // Total is 1, so mass arriving from the others is spread * (1 - x_i)
+        shares[i] = (1.0 - mutationRate) * shares[i] + spread * (1.0 - shares[i]);
+    }
+}
+
+void EvolutionaryDynamics::bestResponseStep() {
+    fitnessMatrix.multiply(shares, fitness);
+    size_t best = std::max_element(fitness.begin(), fitness.end()) - fitness.begin();
+
+    for (size_t i = 0; i < shares.size(); ++i) {
+        shares[i] *= (1.0 - responseRate);
+    }
+    shares[best] += responseRate;
+}
+
+void EvolutionaryDynamics::normalise(std::vector<double>& x) const {
+    double total = 0.0;
+    for (double& share : x) {
+        share = std::max(share, 0.0);
+        total += share;
+    }
+    for (double& share : x) {
+        share /= total;
+    }
+}
+
+// L1 distance between two share vectors
+double EvolutionaryDynamics::distance(const std::vector<double>& a, const std::vector<double>& b) {
+    double total = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        total += std::abs(a[i] - b[i]);
+    }
+    return total;
+}
+
+// A small step alone does not make a fixed point: a population drifting slowly along a neutral
+// direction also moves very little each generation. Steps towards a fixed point shrink
+// geometrically, so the ratio of the last two steps estimates how far the shares still have to
+// move (step / (1 - ratio)), and only that remaining distance is tested. A strategy invading from
+// a tiny share also makes a tiny step, so no share may still be growing by a steady factor either.
+// A cycle of length k returns to the shares of k generations ago while still taking steps of
+// ordinary size.
+void EvolutionaryDynamics::detectConvergence() {
+    if (!recentShares.empty()) {
+        const std::vector<double>& previous = recentShares.back();
+        double lastStep = distance(shares, previous);
+
+        bool invading = false;
+        for (size_t i = 0; i < shares.size(); ++i) {
+            invading = invading || shares[i] > previous[i] * (1.0 + invasionTolerance);
+        }
+
+        if (lastStep < convergenceTolerance && !invading) {
+            // Steps at rounding level carry no ratio information and count as standing still
+            bool converged = lastStep < roundingTolerance;
+            if (!converged && recentShares.size() > 1) {
+                double previousStep = distance(previous, recentShares[recentShares.size() - 2]);
+                double ratio = lastStep / previousStep;
+                converged = ratio < 1.0 && lastStep / (1.0 - ratio) < convergenceTolerance;
+            }
+            if (converged) {
+                cycleLength = 1;
+                return;
+            }
+        }
+        else if (lastStep >= convergenceTolerance) {
+            for (size_t back = 1; back < recentShares.size(); ++back) {
+                if (distance(shares, recentShares[recentShares.size() - 1 - back]) < convergenceTolerance) {
+                    cycleLength = static_cast<int>(back) + 1;
+                    return;
+                }
+            }
+        }
+    }
+
+    // Recycle the oldest buffer once the window is full rather than allocating every generation
+    if (recentShares.size() < cycleWindow) {
+        recentShares.push_back(shares);
+    }
+    else {
+        recentShares.push_back(std::move(recentShares.front()));
+        recentShares.pop_front();
+        recentShares.back() = shares;
+    }
+}
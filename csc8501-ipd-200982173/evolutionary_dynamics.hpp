@@ -0,0 +1,72 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include "strategy_matrix.hpp"
+
+enum class DynamicsType {
+    Discrete,     // Discrete-time replicator (simple proportional selection)
+    Continuous,   // Continuous replicator ODE, integrated with adaptive RK4 over one time unit per generation
+    Mutator,      // Discrete replicator followed by uniform mutation between strategies
+    BestResponse  // A fraction of the population (--response-rate) switches to the current best response
+};
+
+// Everything needed to continue a run exactly where it stopped
+struct DynamicsState {
+    std::vector<double> shares;
+    std::vector<std::vector<double>> recentShares;
+    int cycleLength = 0;
+    double stepSize = 0.1;
+};
+
+// Population dynamics over a precomputed fitness matrix, where fitnessMatrix(i, j) is the payoff
+// strategy i earns against strategy j. Shares always sum to 1.
+class EvolutionaryDynamics {
+public:
+    EvolutionaryDynamics(const StrategyMatrix<double>& fitnessMatrix, DynamicsType type, double mutationRate = 0.0, double responseRate = 0.1);
+
+    static DynamicsType parseType(const std::string& name);
+
+    void setShares(const std::vector<double>& newShares);
+    const std::vector<double>& getShares() const { return shares; }
+
+    DynamicsState saveState() const;
+    void restoreState(const DynamicsState& state);
+
+    void step();
+    bool hasConverged() const { return cycleLength > 0; }
+    int getCycleLength() const { return cycleLength; } // 1 = fixed point, 0 = not converged
+
+private:
+    const StrategyMatrix<double>& fitnessMatrix;
+    DynamicsType type;
+    double mutationRate;
+    double responseRate;
+    std::vector<double> shares;
+    std::vector<double> fitness; // scratch buffer for the matrix-vector product
+    std::deque<std::vector<double>> recentShares; // for fixed point / cycle detection
+    int cycleLength = 0;
+    double stepSize = 0.1; // continuous dynamics step, adapted between generations
+    // Scratch buffers for the continuous dynamics, reused so a generation allocates nothing
+    std::vector<double> k1, k2, k3, k4, temp;
+    std::vector<double> full, half, twoHalves;
+
+    static constexpr double convergenceTolerance = 1e-10;
+    static constexpr double roundingTolerance = 1e-14;
+    static constexpr double invasionTolerance = 1e-6; // relative growth of one share per generation
+    static constexpr size_t cycleWindow = 16;
+    // Per-share RK4 error allowed for each step: absolute near zero, relative elsewhere
+    static constexpr double odeAbsoluteTolerance = 1e-12;
+    static constexpr double odeRelativeTolerance = 1e-8;
+
+    void discreteStep();
+    void continuousStep();
+    void mutatorStep();
+    void bestResponseStep();
+
+    void replicatorDerivative(const std::vector<double>& x, std::vector<double>& dxdt);
+    void rungeKuttaStep(const std::vector<double>& x, double h, std::vector<double>& out);
+    void normalise(std::vector<double>& x) const;
+    void detectConvergence();
+    static double distance(const std::vector<double>& a, const std::vector<double>& b);
+};
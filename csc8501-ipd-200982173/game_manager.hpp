@@ -3,12 +3,17 @@
 #include <random>
 #include "payoff.hpp"
 #include "strategy.hpp"
+#include "round_metrics.hpp"
+#include "random_stream.hpp"
 
 template <typename T>
 class GameManager {
 public:
-    GameManager(std::unique_ptr<Strategy> s1, std::unique_ptr<Strategy> s2, const Payoff<T>& payoff, double epsilon, std::mt19937& randNumGen, bool noiseOn, const std::string& outputFormat);
+    GameManager(std::unique_ptr<Strategy> s1, std::unique_ptr<Strategy> s2, const Payoff<T>& payoff, double epsilon, RandomStream& randNumGen, bool noiseOn, const std::string& outputFormat);
     void runGame(int rounds, int repetition, int totalRepeats);
+    // Also passes every round's moves to the given RoundMetrics collectors
+    template <typename Metrics>
+    void runGame(int rounds, int repetition, int totalRepeats, Metrics& metrics);
     void printResults() const;
     const Strategy* getPlayer1Strategy() { return player1Strategy.get(); }
     const Strategy* getPlayer2Strategy() { return player2Strategy.get(); }
@@ -19,7 +24,7 @@ private:
     const Payoff<T>& payoffSystem;
     double epsilon;
     bool noiseOn;  
-    std::mt19937& randNumGen;
+    RandomStream& randNumGen;
     std::uniform_real_distribution<double> distribution{ 0.0, 1.0 };
     std::string outputFormat;
 };
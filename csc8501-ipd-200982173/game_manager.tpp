@@ -4,7 +4,7 @@
 #include "prober_strategy.hpp"
 
 template <typename T>
-GameManager<T>::GameManager(std::unique_ptr<Strategy> s1, std::unique_ptr<Strategy> s2, const Payoff<T>& payoff, double epsilon, std::mt19937& randNumGen, bool noiseOn, const std::string& outputFormat)
+GameManager<T>::GameManager(std::unique_ptr<Strategy> s1, std::unique_ptr<Strategy> s2, const Payoff<T>& payoff, double epsilon, RandomStream& randNumGen, bool noiseOn, const std::string& outputFormat)
     : player1Strategy(std::move(s1)),
     player2Strategy(std::move(s2)),
     payoffSystem(payoff),
@@ -16,6 +16,13 @@ GameManager<T>::GameManager(std::unique_ptr<Strategy> s1, std::unique_ptr<Strate
 
 template <typename T>
 void GameManager<T>::runGame(int rounds, int repetition, int totalRepeats) {
+    NoMetrics metrics;
+    runGame(rounds, repetition, totalRepeats, metrics);
+}
+
+template <typename T>
+template <typename Metrics>
+void GameManager<T>::runGame(int rounds, int repetition, int totalRepeats, Metrics& metrics) {
     Action p1LastAction = Action::Cooperate;
     Action p2LastAction = Action::Cooperate;
     bool p1OpponentDefected = false;
@@ -23,6 +30,7 @@ void GameManager<T>::runGame(int rounds, int repetition, int totalRepeats) {
     
     player1Strategy->resetScore();
     player2Strategy->resetScore();
+    metrics.beginGame(rounds);
 
     if (outputFormat == "text") {
         std::cout << "----------------------------------";
@@ -53,8 +61,8 @@ void GameManager<T>::runGame(int rounds, int repetition, int totalRepeats) {
         Action p1Action = player1Strategy->decideAction(state1);
         Action p2Action = player2Strategy->decideAction(state2);
 
-        bool p1ActionFlipped = false;
-        bool p2ActionFlipped = false;
+        [[maybe_unused]] bool p1ActionFlipped = false;
+        [[maybe_unused]] bool p2ActionFlipped = false;
 
         if (noiseOn) {
             bool p1IsProber = (dynamic_cast<PROBER*>(player1Strategy.get()) != nullptr);
@@ -118,6 +126,7 @@ void GameManager<T>::runGame(int rounds, int repetition, int totalRepeats) {
 
         player1Strategy->addScore(p1Score);
         player2Strategy->addScore(p2Score);
+        metrics.recordRound(round, p1Cooperated, p2Cooperated);
 
         // Store last actions for next round
         p1LastAction = p1Action;
@@ -132,6 +141,8 @@ void GameManager<T>::runGame(int rounds, int repetition, int totalRepeats) {
                 << " - " << player2Strategy->getScore() << "\n";
         }
     }
+    metrics.endGame();
+
     if (outputFormat == "text") {
         printResults();
     }
@@ -11,6 +11,6 @@ Action GRIM::decideAction(const GameState& state) {
     return Action::Cooperate;
 }
 
-std::string GRIM::name() const {
+std::string_view GRIM::name() const {
     return "GRIM";
 }
\ No newline at end of file
@@ -5,7 +5,8 @@
 class GRIM : public Strategy {
 public:
     Action decideAction(const GameState& state) override;
-    std::string name() const override;
+    std::string_view name() const override;
+    bool isDeterministic() const override { return true; }
 private:
     bool opponentDefected = false; // Track if opponent has ever defected
 };
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include "memory_budget.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+#endif
+
+namespace {
+    std::string toMiB(std::uint64_t bytes) {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(1) << bytes / (1024.0 * 1024.0) << " MiB";
+        return text.str();
+    }
+}
+
+void MemoryBudget::require(std::uint64_t estimatedBytes, const std::string& what) const {
+    std::uint64_t inUse = currentResidentBytes();
+    if (inUse + estimatedBytes > budgetBytes) {
+        throw std::invalid_argument("Error - " + what + " needs about " + toMiB(inUse + estimatedBytes)
+            + ", more than --max-memory " + toMiB(budgetBytes));
+    }
+}
+
+void MemoryBudget::check(const std::string& what) const {
+    std::uint64_t inUse = currentResidentBytes();
+    if (inUse > budgetBytes) {
+        throw std::runtime_error("Error - memory in use reached " + toMiB(inUse) + " while " + what
+            + ", more than --max-memory " + toMiB(budgetBytes));
+    }
+}
+
+std::uint64_t MemoryBudget::remainingBytes() const {
+    std::uint64_t inUse = currentResidentBytes();
+    return inUse < budgetBytes ? budgetBytes - inUse : 0;
+}
+
+void MemoryBudget::reportPeak() const {
+    std::uint64_t peak = peakResidentBytes();
+    if (peak == 0) {
+        std::cout << "\n- Peak memory: not available on this platform\n";
+        return;
+    }
+
+    std::cout << "\n- Peak memory: " << toMiB(peak) << " of " << toMiB(budgetBytes) << " budget\n";
+    if (peak > budgetBytes) {
+        std::cout << "  Warning - peak memory exceeded --max-memory\n";
+    }
+}
+
+std::uint64_t MemoryBudget::currentResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.WorkingSetSize;
+#elif defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+        return peakResidentBytes();
+    }
+    return static_cast<std::uint64_t>(info.resident_size);
+#else
+    // Second field of statm is the resident set in pages
+    std::ifstream statm("/proc/self/statm");
+    std::uint64_t totalPages = 0;
+    std::uint64_t residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) {
+        return peakResidentBytes();
+    }
+    return residentPages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+std::uint64_t MemoryBudget::peakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<std::uint64_t>(usage.ru_maxrss); // bytes on macOS
+#else
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024; // kilobytes on Linux
+#endif
+#endif
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Resident memory checks for --max-memory runs. A run estimates its largest allocations before
+// it starts, so a job that would not fit fails straight away instead of growing until the box
+// runs out of memory. Containers that grow while the run is going are sized from what is left of
+// the budget, and the run stops with an error if it goes over anyway.
+class MemoryBudget {
+public:
+    explicit MemoryBudget(std::uint64_t budgetMiB) : budgetBytes(budgetMiB * 1024 * 1024) {}
+
+    // Throws when the memory in use now plus the estimate would exceed the budget
+    void require(std::uint64_t estimatedBytes, const std::string& what) const;
+    // Throws when the memory in use now already exceeds the budget
+    void check(const std::string& what) const;
+    // Budget not yet taken by the memory in use now
+    std::uint64_t remainingBytes() const;
+    // Prints the peak resident set size against the budget
+    void reportPeak() const;
+
+    // Resident set of the process right now, in bytes, falling back to the peak where the
+    // current size is not available
+    static std::uint64_t currentResidentBytes();
+    // Largest resident set the process has reached, in bytes, or 0 where it is not available
+    static std::uint64_t peakResidentBytes();
+
+private:
+    std::uint64_t budgetBytes;
+};
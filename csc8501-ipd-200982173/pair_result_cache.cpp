@@ -0,0 +1,77 @@
+#include "pair_result_cache.hpp"
+
+PairResultCache::PairResultCache(size_t capacity)
+    : capacity(capacity) {
+}
+
+PairResultCache::Result PairResultCache::getOrCompute(const std::string& key, const std::function<Result()>& compute, bool& wasCached) {
+    std::promise<Result> promise;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        auto cached = index.find(key);
+        if (cached != index.end()) {
+            entries.splice(entries.begin(), entries, cached->second);
+            hits++;
+            wasCached = true;
+            return cached->second->second;
+        }
+
+        auto running = inFlight.find(key);
+        if (running != inFlight.end()) {
+            std::shared_future<Result> pending = running->second;
+            hits++;
+            lock.unlock();
+            wasCached = true;
+            return pending.get();
+        }
+
+        inFlight.emplace(key, promise.get_future().share());
+        misses++;
+    }
+
+    wasCached = false;
+    try {
+        Result result = compute();
+        std::lock_guard<std::mutex> lock(mutex);
+        insert(key, result);
+        inFlight.erase(key);
+        promise.set_value(result);
+        return result;
+    }
+    catch (...) {
+        // Waiting jobs see the same failure, and the next request tries again
+        std::lock_guard<std::mutex> lock(mutex);
+        inFlight.erase(key);
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+void PairResultCache::insert(const std::string& key, const Result& result) {
+    if (capacity == 0 || index.count(key)) {
+        return;
+    }
+    entries.emplace_front(key, result);
+    index[key] = entries.begin();
+
+    if (entries.size() > capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+// The key is stored twice (list entry and index), plus a list node and a hash node around them
+std::uint64_t PairResultCache::entryBytes(size_t keyLength) {
+    return 2 * (sizeof(std::string) + keyLength) + sizeof(Result) + 6 * sizeof(void*);
+}
+
+size_t PairResultCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+size_t PairResultCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
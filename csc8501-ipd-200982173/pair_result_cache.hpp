@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <list>
+#include <string>
+#include <mutex>
+#include <future>
+#include <functional>
+#include <unordered_map>
+#include "score_accumulator.hpp"
+
+// Least-recently-used cache of pairing results shared between jobs. A pairing that another job is
+// already computing is waited on rather than simulated a second time.
+class PairResultCache {
+public:
+    using Result = std::pair<ScoreAccumulator, ScoreAccumulator>;
+
+    explicit PairResultCache(size_t capacity);
+
+    // wasCached is set when the result came from the cache or from another job's computation
+    Result getOrCompute(const std::string& key, const std::function<Result()>& compute, bool& wasCached);
+
+    size_t getHits() const;
+    size_t getMisses() const;
+    size_t getCapacity() const { return capacity; }
+
+    // Approximate memory held by one cached entry with a key of the given length
+    static std::uint64_t entryBytes(size_t keyLength);
+
+private:
+    size_t capacity;
+    mutable std::mutex mutex;
+    std::list<std::pair<std::string, Result>> entries; // most recently used at the front
+    std::unordered_map<std::string, std::list<std::pair<std::string, Result>>::iterator> index;
+    std::unordered_map<std::string, std::shared_future<Result>> inFlight;
+    size_t hits = 0;
+    size_t misses = 0;
+
+    void insert(const std::string& key, const Result& result);
+};
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <latch>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include "pair_scheduler.hpp"
+
+PairScheduler::PairScheduler(size_t threadCount)
+    : threadCount(std::max<size_t>(1, threadCount)) {
+}
+
+void PairScheduler::run(const std::vector<double>& costs, const std::function<void(size_t)>& job) {
+    auto start = std::chrono::steady_clock::now();
+
+    // Largest estimated cost first
+    std::vector<size_t> order(costs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return costs[a] > costs[b];
+    });
+
+    // Consecutive jobs share a chunk until it reaches the target cost, so a job at least that
+    // expensive gets a chunk to itself
+    double totalCost = std::accumulate(costs.begin(), costs.end(), 0.0);
+    double targetCost = totalCost / (threadCount * chunksPerWorker);
+    std::vector<size_t> chunkStarts;
+    double chunkCost = 0.0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (chunkStarts.empty() || chunkCost >= targetCost) {
+            chunkStarts.push_back(i);
+            chunkCost = 0.0;
+        }
+        chunkCost += costs[order[i]];
+    }
+    chunkStarts.push_back(order.size());
+
+    jobCount = costs.size();
+    chunkCount = chunkStarts.size() - 1;
+    size_t workerCount = std::min(threadCount, std::max<size_t>(1, chunkCount));
+    utilisation.assign(workerCount, {});
+
+    std::atomic<size_t> nextChunk{ 0 };
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+    // Nobody starts until every worker is up, so short runs are not finished by the first
+    // threads before the last ones have been created
+    std::latch started(static_cast<std::ptrdiff_t>(workerCount));
+
+    auto workerLoop = [&](size_t worker) {
+        started.arrive_and_wait();
+        for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+            auto chunkStart = std::chrono::steady_clock::now();
+            try {
+                for (size_t i = chunkStarts[chunk]; i < chunkStarts[chunk + 1]; ++i) {
+                    job(order[i]);
+                    utilisation[worker].jobs++;
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                nextChunk = chunkCount; // let the other workers stop early
+            }
+            utilisation[worker].busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - chunkStart).count();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t worker = 1; worker < workerCount; ++worker) {
+        workers.emplace_back(workerLoop, worker);
+    }
+    workerLoop(0); // the calling thread works too
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+void PairScheduler::printReport(std::ostream& out) const {
+    out << "\n- Scheduler: " << jobCount << " jobs in " << chunkCount << " chunks on " << utilisation.size()
+        << " workers, " << wallSeconds << " s\n";
+    for (size_t worker = 0; worker < utilisation.size(); ++worker) {
+        double share = wallSeconds > 0.0 ? utilisation[worker].busySeconds / wallSeconds * 100.0 : 0.0;
+        out << "  Worker " << worker << ": " << utilisation[worker].jobs << " jobs, busy "
+            << utilisation[worker].busySeconds << " s (" << share << "%)\n";
+    }
+}
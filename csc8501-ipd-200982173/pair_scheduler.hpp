@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <ostream>
+
+// Busy time of one scheduler worker over a run
+struct WorkerUtilisation {
+    size_t jobs = 0;
+    double busySeconds = 0.0;
+};
+
+// Runs jobs of uneven estimated cost across a fixed number of threads. Jobs are sorted largest
+// first and packed into chunks of roughly equal cost, so an expensive pairing never ends up
+// alone at the back of the queue while cheap ones are batched to keep dispatch overhead low.
+// Workers claim the next chunk as soon as they finish their last one.
+class PairScheduler {
+public:
+    explicit PairScheduler(size_t threadCount);
+
+    // Calls job(i) for every i in [0, costs.size()) and returns once all have finished.
+    // The first exception thrown by a job is rethrown here.
+    void run(const std::vector<double>& costs, const std::function<void(size_t)>& job);
+
+    void printReport(std::ostream& out) const;
+
+private:
+    static constexpr size_t chunksPerWorker = 8;
+
+    size_t threadCount;
+    size_t jobCount = 0;
+    size_t chunkCount = 0;
+    double wallSeconds = 0.0;
+    std::vector<WorkerUtilisation> utilisation;
+};
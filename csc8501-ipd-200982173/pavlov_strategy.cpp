@@ -14,6 +14,6 @@ Action PAVLOV::decideAction(const GameState& state) {
     }
 }
 
-std::string PAVLOV::name() const {
+std::string_view PAVLOV::name() const {
     return "PAVLOV";
 }
\ No newline at end of file
@@ -58,6 +58,6 @@ Action PROBER::decideAction(const GameState& state) {
     return state.lastOpponentMove;
 }
 
-std::string PROBER::name() const {
+std::string_view PROBER::name() const {
     return "PROBER";
 }
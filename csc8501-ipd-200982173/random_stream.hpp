@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+// Counter-based random engine for the independent streams of a tournament. Every repeat has its
+// own noise stream and one stream per seat for random strategies, keyed on (seed, repeat, seat) so
+// any repeat can be played on its own, in any process. Keys and draws both go through the
+// splitmix64 mixer, so starting a stream costs a few multiplications, where an mt19937 seeded
+// from a std::seed_seq has to generate and refill 624 words before its first draw.
+// Satisfies UniformRandomBitGenerator, so it works with the <random> distributions.
+class RandomStream {
+public:
+    using result_type = std::uint64_t;
+
+    static constexpr int noiseSeat = 0; // players sit in seats 1 and 2
+
+    explicit RandomStream(std::uint64_t seed = 0) : counter(mix(seed)) {}
+    RandomStream(int seed, int repeat, int seat) { reset(seed, repeat, seat); }
+
+    void reset(int seed, int repeat, int seat) {
+        counter = mix(mix(mix(static_cast<std::uint32_t>(seed)) ^ static_cast<std::uint32_t>(repeat)) ^ static_cast<std::uint32_t>(seat));
+    }
+
+    result_type operator()() {
+        counter += increment;
+        return mix(counter);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+private:
+    static constexpr std::uint64_t increment = 0x9E3779B97F4A7C15ULL;
+    std::uint64_t counter;
+
+    // splitmix64 finaliser: every input bit affects every output bit
+    static std::uint64_t mix(std::uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+};
@@ -37,7 +37,7 @@ Action RIVAL::decideAction(const GameState& state) {
     }
 }
 
-std::string RIVAL::name() const {
+std::string_view RIVAL::name() const {
     return "RIVAL";
 }
 
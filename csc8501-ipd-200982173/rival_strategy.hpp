@@ -8,7 +8,8 @@ public:
     RIVAL();
 
     Action decideAction(const GameState& state) override;
-    std::string name() const override;
+    std::string_view name() const override;
+    bool isDeterministic() const override { return true; }
 private:
     double scoreDiffThreshold;
     bool catchupActive;
@@ -1,7 +1,7 @@
 #include "rnd_strategy.hpp"
 
-RND::RND(double probability)
-    : p(probability), randNum(std::random_device{}()), rangeLimit(0.0, 1.0) {
+RND::RND(double probability, RandomStream randNum)
+    : p(probability), randNum(randNum), rangeLimit(0.0, 1.0) {
 }
 
 // Randomly decide each round based on the value of p
@@ -15,6 +15,6 @@ Action RND::decideAction(const GameState&) {
     }
 }
 
-std::string RND::name() const {
+std::string_view RND::name() const {
     return "RND";
 }
\ No newline at end of file
@@ -1,14 +1,16 @@
 #pragma once
 #include "strategy.hpp"
 #include <random>
+#include "random_stream.hpp"
 
 class RND : public Strategy {
 public:
-    RND(double probability);
+    RND(double probability, RandomStream randNum);
     Action decideAction(const GameState& state) override;
-    std::string name() const override;
+    std::string_view name() const override;
+    bool isDeterministic() const override { return false; }
 private:
     double p;
-    std::mt19937 randNum;
+    RandomStream randNum;
     std::uniform_real_distribution<double> rangeLimit;
 };
\ No newline at end of file
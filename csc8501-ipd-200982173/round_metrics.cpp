@@ -0,0 +1,96 @@
+#include <utility>
+#include "round_metrics.hpp"
+
+namespace {
+    // Mean of an accumulator, or N/A when nothing was recorded
+    void writeMean(std::ostream& out, const ScoreAccumulator& values) {
+        if (values.getCount() == 0) {
+            out << ",N/A";
+        }
+        else {
+            out << "," << values.getMean();
+        }
+    }
+
+    double share(std::uint64_t count, std::uint64_t games) {
+        return games > 0 ? static_cast<double>(count) / games : 0.0;
+    }
+}
+
+void CooperationRate::merge(const CooperationRate& other) {
+    if (other.p1Cooperations.size() > p1Cooperations.size()) {
+        p1Cooperations.resize(other.p1Cooperations.size(), 0);
+        p2Cooperations.resize(other.p2Cooperations.size(), 0);
+    }
+    for (size_t i = 0; i < other.p1Cooperations.size(); ++i) {
+        p1Cooperations[i] += other.p1Cooperations[i];
+        p2Cooperations[i] += other.p2Cooperations[i];
+    }
+    games += other.games;
+}
+
+void CooperationRate::mirror() {
+    std::swap(p1Cooperations, p2Cooperations);
+}
+
+void CooperationRate::writeHeader(std::ostream& out) {
+    out << ",CoopRate[1],CoopRate[2]";
+}
+
+// Overall rate across every round of every game
+void CooperationRate::writeValues(std::ostream& out) const {
+    std::uint64_t p1Total = 0;
+    std::uint64_t p2Total = 0;
+    for (size_t i = 0; i < p1Cooperations.size(); ++i) {
+        p1Total += p1Cooperations[i];
+        p2Total += p2Cooperations[i];
+    }
+    std::uint64_t roundsPlayed = games * p1Cooperations.size();
+    out << "," << share(p1Total, roundsPlayed) << "," << share(p2Total, roundsPlayed);
+}
+
+void FirstDefection::merge(const FirstDefection& other) {
+    p1Rounds.merge(other.p1Rounds);
+    p2Rounds.merge(other.p2Rounds);
+}
+
+void FirstDefection::mirror() {
+    std::swap(p1Rounds, p2Rounds);
+}
+
+void FirstDefection::writeHeader(std::ostream& out) {
+    out << ",FirstDefection[1],FirstDefection[2]";
+}
+
+void FirstDefection::writeValues(std::ostream& out) const {
+    writeMean(out, p1Rounds);
+    writeMean(out, p2Rounds);
+}
+
+void RetaliationCycles::merge(const RetaliationCycles& other) {
+    games += other.games;
+    lengths.merge(other.lengths);
+}
+
+void RetaliationCycles::writeHeader(std::ostream& out) {
+    out << ",RetaliationCyclesPerGame,RetaliationLength";
+}
+
+void RetaliationCycles::writeValues(std::ostream& out) const {
+    out << "," << share(lengths.getCount(), games);
+    writeMean(out, lengths);
+}
+
+void MutualDefectionLockIn::merge(const MutualDefectionLockIn& other) {
+    games += other.games;
+    startRounds.merge(other.startRounds);
+}
+
+void MutualDefectionLockIn::writeHeader(std::ostream& out) {
+    out << ",LockInRate,LockInRound";
+}
+
+void MutualDefectionLockIn::writeValues(std::ostream& out) const {
+    out << "," << share(startRounds.getCount(), games);
+    writeMean(out, startRounds);
+}
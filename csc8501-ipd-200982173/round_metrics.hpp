@@ -0,0 +1,192 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "score_accumulator.hpp"
+
+// Per-round collectors. Each one watches the moves of every round of a game and folds them into
+// totals for the pairing, which can be merged across repeats and mirrored for the reverse seating.
+
+// Share of games in which each player cooperated, round by round
+class CooperationRate {
+public:
+    void beginGame(int rounds) {
+        if (static_cast<size_t>(rounds) > p1Cooperations.size()) {
+            p1Cooperations.resize(rounds, 0);
+            p2Cooperations.resize(rounds, 0);
+        }
+        games++;
+    }
+    void recordRound(int round, bool p1Cooperated, bool p2Cooperated) {
+        p1Cooperations[round - 1] += p1Cooperated;
+        p2Cooperations[round - 1] += p2Cooperated;
+    }
+    void endGame() {}
+
+    void merge(const CooperationRate& other);
+    void mirror();
+    static void writeHeader(std::ostream& out);
+    void writeValues(std::ostream& out) const;
+
+    std::uint64_t getGames() const { return games; }
+    size_t getRounds() const { return p1Cooperations.size(); }
+    double getP1Rate(int round) const { return games > 0 ? static_cast<double>(p1Cooperations[round - 1]) / games : 0.0; }
+    double getP2Rate(int round) const { return games > 0 ? static_cast<double>(p2Cooperations[round - 1]) / games : 0.0; }
+
+private:
+    std::uint64_t games = 0;
+    // Counts fit in 32 bits because a pairing never plays more than --repeats games
+    std::vector<std::uint32_t> p1Cooperations;
+    std::vector<std::uint32_t> p2Cooperations;
+};
+
+// Round of each player's first defection, over the games in which they defected at all
+class FirstDefection {
+public:
+    void beginGame(int) {
+        p1First = 0;
+        p2First = 0;
+    }
+    void recordRound(int round, bool p1Cooperated, bool p2Cooperated) {
+        if (!p1Cooperated && p1First == 0) {
+            p1First = round;
+        }
+        if (!p2Cooperated && p2First == 0) {
+            p2First = round;
+        }
+    }
+    void endGame() {
+        if (p1First > 0) {
+            p1Rounds.add(p1First);
+        }
+        if (p2First > 0) {
+            p2Rounds.add(p2First);
+        }
+    }
+
+    void merge(const FirstDefection& other);
+    void mirror();
+    static void writeHeader(std::ostream& out);
+    void writeValues(std::ostream& out) const;
+
+private:
+    int p1First = 0;
+    int p2First = 0;
+    ScoreAccumulator p1Rounds;
+    ScoreAccumulator p2Rounds;
+};
+
+// Runs of two or more rounds where exactly one player defects and the roles swap every round,
+// the echo that follows a single defection between two reciprocating strategies
+class RetaliationCycles {
+public:
+    void beginGame(int) {
+        runLength = 0;
+        games++;
+    }
+    void recordRound(int, bool p1Cooperated, bool p2Cooperated) {
+        if (p1Cooperated == p2Cooperated) {
+            closeRun();
+            return;
+        }
+        bool p1Defected = !p1Cooperated;
+        if (runLength > 0 && p1Defected != lastDefectorP1) {
+            runLength++;
+        }
+        else {
+            closeRun();
+            runLength = 1;
+        }
+        lastDefectorP1 = p1Defected;
+    }
+    void endGame() { closeRun(); }
+
+    void merge(const RetaliationCycles& other);
+    void mirror() {}
+    static void writeHeader(std::ostream& out);
+    void writeValues(std::ostream& out) const;
+
+private:
+    void closeRun() {
+        if (runLength >= 2) {
+            lengths.add(runLength);
+        }
+        runLength = 0;
+    }
+
+    int runLength = 0;
+    bool lastDefectorP1 = false;
+    std::uint64_t games = 0;
+    ScoreAccumulator lengths;
+};
+
+// Games that end in unbroken mutual defection, and the round that run started
+class MutualDefectionLockIn {
+public:
+    void beginGame(int) {
+        runStart = 0;
+        games++;
+    }
+    void recordRound(int round, bool p1Cooperated, bool p2Cooperated) {
+        if (p1Cooperated || p2Cooperated) {
+            runStart = 0;
+        }
+        else if (runStart == 0) {
+            runStart = round;
+        }
+    }
+    void endGame() {
+        if (runStart > 0) {
+            startRounds.add(runStart);
+        }
+    }
+
+    void merge(const MutualDefectionLockIn& other);
+    void mirror() {}
+    static void writeHeader(std::ostream& out);
+    void writeValues(std::ostream& out) const;
+
+private:
+    int runStart = 0;
+    std::uint64_t games = 0;
+    ScoreAccumulator startRounds;
+};
+
+// Moves of the most recent game, one entry per round: bit 0 is set when player 1 cooperated and
+// bit 1 when player 2 did. Kept for printing a replayed game and for --verify, not merged.
+class MoveHistory {
+public:
+    void beginGame(int rounds) {
+        moves.clear();
+        moves.reserve(rounds);
+    }
+    void recordRound(int, bool p1Cooperated, bool p2Cooperated) {
+        moves.push_back(static_cast<char>(p1Cooperated | (p2Cooperated << 1)));
+    }
+    void endGame() {}
+
+    const std::vector<char>& getMoves() const { return moves; }
+
+private:
+    std::vector<char> moves;
+};
+
+// A fixed set of collectors chosen at compile time. GameManager calls every collector inline each
+// round, so RoundMetrics<> with no collectors compiles away to nothing.
+template <typename... Collectors>
+class RoundMetrics : public Collectors... {
+public:
+    void beginGame([[maybe_unused]] int rounds) { (Collectors::beginGame(rounds), ...); }
+    void recordRound([[maybe_unused]] int round, [[maybe_unused]] bool p1Cooperated, [[maybe_unused]] bool p2Cooperated) { (Collectors::recordRound(round, p1Cooperated, p2Cooperated), ...); }
+    void endGame() { (Collectors::endGame(), ...); }
+
+    void merge(const RoundMetrics& other);
+    RoundMetrics mirrored() const;
+    static void writeHeader(std::ostream& out);
+    void writeValues(std::ostream& out) const;
+};
+
+using NoMetrics = RoundMetrics<>;
+using TournamentMetrics = RoundMetrics<CooperationRate, FirstDefection, RetaliationCycles, MutualDefectionLockIn>;
+
+#include "round_metrics.tpp"
@@ -0,0 +1,25 @@
+#pragma once
+
+template <typename... Collectors>
+void RoundMetrics<Collectors...>::merge(const RoundMetrics& other) {
+    (Collectors::merge(other), ...);
+}
+
+// The same totals seen from the other seat
+template <typename... Collectors>
+RoundMetrics<Collectors...> RoundMetrics<Collectors...>::mirrored() const {
+    RoundMetrics result = *this;
+    (result.Collectors::mirror(), ...);
+    return result;
+}
+
+// Each collector adds its own comma-prefixed columns
+template <typename... Collectors>
+void RoundMetrics<Collectors...>::writeHeader(std::ostream& out) {
+    (Collectors::writeHeader(out), ...);
+}
+
+template <typename... Collectors>
+void RoundMetrics<Collectors...>::writeValues(std::ostream& out) const {
+    (Collectors::writeValues(out), ...);
+}
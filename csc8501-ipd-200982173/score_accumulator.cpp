@@ -0,0 +1,33 @@
+#include <cmath>
+#include "score_accumulator.hpp"
+
+void ScoreAccumulator::add(double score) {
+    double oldMean = getMean();
+    count++;
+    sum += score;
+    m2 += (score - oldMean) * (score - getMean());
+}
+
+// Chan et al. pairwise combination of two partial variances
+void ScoreAccumulator::merge(const ScoreAccumulator& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+
+    double delta = other.getMean() - getMean();
+    double total = static_cast<double>(count + other.count);
+    m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / total);
+    count += other.count;
+    sum += other.sum;
+}
+
+double ScoreAccumulator::getStdev() const {
+    if (count <= 1) {
+        return 0.0;
+    }
+    return std::sqrt(m2 / (count - 1));
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+// Streaming mean / variance of match scores (Welford). Accumulators built over disjoint sets of
+// repeats can be merged, which lets shards of a tournament be combined after the fact.
+class ScoreAccumulator {
+public:
+    ScoreAccumulator() = default;
+    ScoreAccumulator(std::uint64_t count, double sum, double m2) : count(count), sum(sum), m2(m2) {}
+
+    void add(double score);
+    void merge(const ScoreAccumulator& other);
+
+    std::uint64_t getCount() const { return count; }
+    double getSum() const { return sum; }
+    double getM2() const { return m2; } // sum of squared deviations from the mean
+    double getMean() const { return count > 0 ? sum / count : 0.0; }
+    double getStdev() const; // sample standard deviation
+
+private:
+    std::uint64_t count = 0;
+    double sum = 0.0;
+    double m2 = 0.0;
+};
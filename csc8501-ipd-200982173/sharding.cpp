@@ -0,0 +1,219 @@
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <stdexcept>
+#include <cerrno>
+#include "sharding.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+
+namespace {
+    // Worker processes are started from an argument list, never through a shell, so paths and
+    // strategy lists are passed through unchanged whatever characters they contain
+#ifdef _WIN32
+    using Process = HANDLE;
+
+    // Quotes one argument so the C runtime's command line parsing gives it back unchanged
+    std::string quoteArgument(const std::string& arg) {
+        if (!arg.empty() && arg.find_first_of(" \t\n\v\"") == std::string::npos) {
+            return arg;
+        }
+
+        std::string quoted = "\"";
+        size_t backslashes = 0;
+        for (char c : arg) {
+            if (c == '\\') {
+                backslashes++;
+                continue;
+            }
+            // Backslashes are only special in front of a quote
+            quoted.append(c == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+            quoted.push_back(c);
+            backslashes = 0;
+        }
+        quoted.append(backslashes * 2, '\\'); // so the closing quote is not escaped
+        quoted.push_back('"');
+        return quoted;
+    }
+
+    Process startProcess(const std::vector<std::string>& args) {
+        std::string commandLine;
+        for (const auto& arg : args) {
+            commandLine += (commandLine.empty() ? "" : " ") + quoteArgument(arg);
+        }
+
+        STARTUPINFOA startup{};
+        startup.cb = sizeof(startup);
+        PROCESS_INFORMATION process{};
+        if (!CreateProcessA(nullptr, commandLine.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup, &process)) {
+            throw std::runtime_error("Shard worker could not be started: " + args[0]);
+        }
+        CloseHandle(process.hThread);
+        return process.hProcess;
+    }
+
+    int waitForProcess(Process process) {
+        WaitForSingleObject(process, INFINITE);
+        DWORD exitCode = 1;
+        GetExitCodeProcess(process, &exitCode);
+        CloseHandle(process);
+        return static_cast<int>(exitCode);
+    }
+#else
+    using Process = pid_t;
+
+    Process startProcess(const std::vector<std::string>& args) {
+        std::vector<char*> argv;
+        for (const auto& arg : args) {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        // posix_spawnp searches PATH when argv[0] has no directory, as the shell did
+        pid_t pid = 0;
+        if (posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) != 0) {
+            throw std::runtime_error("Shard worker could not be started: " + args[0]);
+        }
+        return pid;
+    }
+
+    int waitForProcess(Process process) {
+        int status = 0;
+        while (waitpid(process, &status, 0) < 0) {
+            if (errno != EINTR) {
+                return -1;
+            }
+        }
+        return (WIFEXITED(status)) ? WEXITSTATUS(status) : -1;
+    }
+#endif
+}
+
+ShardTaskRange Sharding::taskRange(size_t totalTasks, int shard, int shardCount) {
+    return { totalTasks * shard / shardCount, totalTasks * (shard + 1) / shardCount };
+}
+
+// Every option that changes the partial results of a pairing. Strategy order matters as well, as
+// results are stored by registry id.
+std::string Sharding::optionsKey(const CommandOptions& options) {
+    std::ostringstream key;
+    key.precision(17);
+    key << "rounds=" << options.rounds << ";repeats=" << options.repeats << ";strategies=";
+    for (const auto& strat : options.strategies) {
+        key << strat << ",";
+    }
+    key << ";payoff=" << options.t << "," << options.r << "," << options.p << "," << options.s
+        << ";noise=" << options.noiseOn;
+    if (options.noiseOn) {
+        key << ";epsilon=" << options.epsilon;
+    }
+    // RND and TROJAN are seeded from --seed even without noise
+    key << ";seed=" << options.seed;
+    return key.str();
+}
+
+std::string Sharding::shardFilename(const std::string& directory, int shard, int shardCount) {
+    return (std::filesystem::path(directory) / ("shard_" + std::to_string(shard) + "_of_" + std::to_string(shardCount) + ".txt")).string();
+}
+
+// Plain text with 17 significant digits, so values round-trip exactly on any machine
+void Sharding::writeShard(const std::string& path, const std::string& optionsKey, const std::vector<PairResult>& results) {
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Shard file " + tempPath + " could not be created");
+        }
+
+        out << optionsKey << "\n" << results.size() << "\n" << std::setprecision(17);
+        for (const auto& result : results) {
+            out << result.p1 << " " << result.p2 << " "
+                << result.p1Scores.getCount() << " " << result.p1Scores.getSum() << " " << result.p1Scores.getM2() << " "
+                << result.p2Scores.getCount() << " " << result.p2Scores.getSum() << " " << result.p2Scores.getM2() << "\n";
+        }
+
+        if (!out.good()) {
+            throw std::runtime_error("Shard file " + tempPath + " could not be written");
+        }
+    }
+    // Only a complete file is ever visible under the final name
+    std::filesystem::rename(tempPath, path);
+}
+
+std::vector<PairResult> Sharding::readShard(const std::string& path, const std::string& optionsKey) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("Shard file " + path + " could not be opened");
+    }
+
+    std::string key;
+    std::getline(in, key);
+    if (key != optionsKey) {
+        throw std::invalid_argument("Error - shard file " + path + " was created with different options");
+    }
+
+    size_t count = 0;
+    in >> count;
+    std::vector<PairResult> results(count);
+
+    for (auto& result : results) {
+        std::uint64_t p1Count, p2Count;
+        std::string p1Sum, p1M2, p2Sum, p2M2;
+        in >> result.p1 >> result.p2 >> p1Count >> p1Sum >> p1M2 >> p2Count >> p2Sum >> p2M2;
+        if (!in) {
+            throw std::runtime_error("Error - shard file " + path + " is truncated");
+        }
+        result.p1Scores = ScoreAccumulator(p1Count, std::stod(p1Sum), std::stod(p1M2));
+        result.p2Scores = ScoreAccumulator(p2Count, std::stod(p2Sum), std::stod(p2M2));
+    }
+
+    return results;
+}
+
+void Sharding::runMissingWorkers(const CommandOptions& options, const std::string& directory) {
+    std::filesystem::create_directories(directory);
+
+    std::vector<std::pair<int, Process>> workers;
+    std::string startError;
+
+    for (int shard = 0; shard < options.shardCount; ++shard) {
+        if (std::filesystem::exists(shardFilename(directory, shard, options.shardCount))) {
+            continue; // already produced, e.g. by a worker on another machine
+        }
+
+        // Re-run this executable with the original arguments plus the shard selection
+        std::vector<std::string> args = { options.executable };
+        args.insert(args.end(), options.arguments.begin(), options.arguments.end());
+        args.insert(args.end(), { "--shard", std::to_string(shard) + "/" + std::to_string(options.shardCount), "--shard-dir", directory });
+
+        try {
+            workers.push_back({ shard, startProcess(args) });
+        }
+        catch (const std::runtime_error& e) {
+            // Still wait for the workers already running before reporting
+            startError = e.what();
+            break;
+        }
+    }
+
+    std::string failedShards;
+    for (auto [shard, process] : workers) {
+        if (waitForProcess(process) != 0) {
+            failedShards += (failedShards.empty() ? "" : ", ") + std::to_string(shard);
+        }
+    }
+
+    if (!startError.empty()) {
+        throw std::runtime_error(startError);
+    }
+    if (!failedShards.empty()) {
+        throw std::runtime_error("Shard worker " + failedShards + " failed");
+    }
+}
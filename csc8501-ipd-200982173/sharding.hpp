@@ -0,0 +1,38 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "cli_parser.hpp"
+#include "strategy_registry.hpp"
+#include "score_accumulator.hpp"
+
+// Accumulated scores for one pairing over some subset of its repeats
+struct PairResult {
+    StrategyId p1;
+    StrategyId p2;
+    ScoreAccumulator p1Scores;
+    ScoreAccumulator p2Scores;
+};
+
+// Contiguous block [begin, end) of the flattened (pair, repeat) task space
+struct ShardTaskRange {
+    size_t begin;
+    size_t end;
+};
+
+// Splits a tournament into shards that run as separate processes. Workers write their partial
+// accumulators to a shard directory, and the coordinator merges them once every file exists.
+// The directory can sit on a shared filesystem, so workers may also be started on other machines.
+// Each repeat seeds its noise and its random strategies from (seed, repeat), so a sharded run gives
+// the same results as an unsharded one.
+class Sharding {
+public:
+    static ShardTaskRange taskRange(size_t totalTasks, int shard, int shardCount);
+    static std::string optionsKey(const CommandOptions& options);
+    static std::string shardFilename(const std::string& directory, int shard, int shardCount);
+
+    static void writeShard(const std::string& path, const std::string& optionsKey, const std::vector<PairResult>& results);
+    static std::vector<PairResult> readShard(const std::string& path, const std::string& optionsKey);
+
+    // Starts a local worker for every shard without a result file and waits for them all
+    static void runMissingWorkers(const CommandOptions& options, const std::string& directory);
+};
@@ -0,0 +1,146 @@
+#include <cctype>
+#include <stdexcept>
+#include "simple_json.hpp"
+
+namespace {
+    class Reader {
+    public:
+        explicit Reader(const std::string& text) : text(text) {}
+
+        void skipSpace() {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+                pos++;
+            }
+        }
+
+        char peek() {
+            skipSpace();
+            if (pos >= text.size()) {
+                throw std::invalid_argument("Error - unexpected end of JSON request");
+            }
+            return text[pos];
+        }
+
+        void expect(char c) {
+            if (peek() != c) {
+                throw std::invalid_argument(std::string("Error - expected '") + c + "' in JSON request");
+            }
+            pos++;
+        }
+
+        std::string readString() {
+            expect('"');
+            std::string value;
+            while (pos < text.size() && text[pos] != '"') {
+                char c = text[pos++];
+                if (c == '\\' && pos < text.size()) {
+                    char escaped = text[pos++];
+                    switch (escaped) {
+                    case 'n': value += '\n'; break;
+                    case 't': value += '\t'; break;
+                    default: value += escaped; break;
+                    }
+                }
+                else {
+                    value += c;
+                }
+            }
+            expect('"');
+            return value;
+        }
+
+        // Numbers and true/false/null are kept as their literal text
+        std::string readScalar() {
+            if (peek() == '"') {
+                return readString();
+            }
+            size_t start = pos;
+            while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '.' || text[pos] == '-' || text[pos] == '+')) {
+                pos++;
+            }
+            if (start == pos) {
+                throw std::invalid_argument("Error - invalid value in JSON request");
+            }
+            return text.substr(start, pos - start);
+        }
+
+        std::string readValue() {
+            if (peek() != '[') {
+                return readScalar();
+            }
+            pos++;
+            std::string joined;
+            if (peek() == ']') {
+                pos++;
+                return joined;
+            }
+            while (true) {
+                if (!joined.empty()) {
+                    joined += ",";
+                }
+                joined += readScalar();
+                if (peek() == ',') {
+                    pos++;
+                    continue;
+                }
+                expect(']');
+                return joined;
+            }
+        }
+
+        bool atEnd() {
+            skipSpace();
+            return pos >= text.size();
+        }
+
+        size_t pos = 0;
+
+    private:
+        const std::string& text;
+    };
+}
+
+std::map<std::string, std::string> SimpleJson::parseObject(const std::string& text) {
+    Reader reader(text);
+    std::map<std::string, std::string> fields;
+
+    reader.expect('{');
+    if (reader.peek() == '}') {
+        reader.pos++;
+    }
+    else {
+        while (true) {
+            std::string key = reader.readString();
+            reader.expect(':');
+            fields[key] = reader.readValue();
+            if (reader.peek() == ',') {
+                reader.pos++;
+                continue;
+            }
+            reader.expect('}');
+            break;
+        }
+    }
+
+    if (!reader.atEnd()) {
+        throw std::invalid_argument("Error - unexpected text after JSON request");
+    }
+    return fields;
+}
+
+std::string SimpleJson::quote(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        }
+        else if (c == '\n') {
+            quoted += "\\n";
+        }
+        else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <map>
+#include <string>
+
+// Minimal JSON support for the simulation server. Requests are flat objects whose values are
+// strings, numbers, booleans or arrays of those; arrays are returned joined with commas so they
+// read the same way as the equivalent command line value (e.g. "ALLC,TFT").
+class SimpleJson {
+public:
+    static std::map<std::string, std::string> parseObject(const std::string& text);
+    static std::string quote(const std::string& text);
+};
@@ -0,0 +1,291 @@
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include "simulation_server.hpp"
+#include "simple_json.hpp"
+#include "tournament_manager.hpp"
+#include "evolutionary_dynamics.hpp"
+#include "memory_budget.hpp"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Request fields that are passed through to the command line parser as --<field> <value>
+    const std::vector<std::string> jobFields = { "rounds", "repeats", "strategies", "payoff", "epsilon", "seed",
+        "population", "generations", "scb", "dynamics", "mutation", "response-rate" };
+
+    // Under --max-memory the cache may hold at most half of the budget left when the server starts
+    size_t cacheCapacity(const CommandOptions& options) {
+        if (options.maxMemory == 0) {
+            return options.cacheSize;
+        }
+        constexpr size_t typicalKeyLength = 96;
+        std::uint64_t fits = MemoryBudget(options.maxMemory).remainingBytes() / 2 / PairResultCache::entryBytes(typicalKeyLength);
+        return static_cast<size_t>(std::min<std::uint64_t>(options.cacheSize, fits));
+    }
+
+    std::string errorResponse(const std::string& message) {
+        return "{\"ok\":false,\"error\":" + SimpleJson::quote(message) + "}";
+    }
+}
+
+SimulationServer::SimulationServer(const CommandOptions& options)
+    : serverOptions(options), cache(cacheCapacity(options)), pool(options.threads) {
+}
+
+#ifdef _WIN32
+
+SimulationServer::Connection::~Connection() {}
+void SimulationServer::Connection::send(const std::string&) {}
+void SimulationServer::readRequests(std::shared_ptr<Connection>) {}
+void SimulationServer::reapReaders() {}
+void SimulationServer::stop() {}
+
+void SimulationServer::run() {
+    throw std::runtime_error("--serve requires Unix domain sockets and is not supported on Windows");
+}
+
+#else
+
+SimulationServer::Connection::~Connection() {
+    close(fd);
+}
+
+void SimulationServer::Connection::send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    std::string message = line + "\n";
+    size_t sent = 0;
+    while (sent < message.size()) {
+        ssize_t written = ::send(fd, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            return; // client went away, nothing else to do with the result
+        }
+        sent += written;
+    }
+}
+
+void SimulationServer::run() {
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error("Server socket could not be created");
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (serverOptions.servePath.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Error - --serve socket path is too long");
+    }
+    std::copy(serverOptions.servePath.begin(), serverOptions.servePath.end(), address.sun_path);
+    unlink(serverOptions.servePath.c_str());
+
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listenFd, 16) < 0) {
+        close(listenFd);
+        throw std::runtime_error("Server could not listen on " + serverOptions.servePath);
+    }
+
+    std::cout << "=====IPD SIMULATION SERVER=====: listening on " << serverOptions.servePath
+        << " | threads: " << pool.size() << " | cache size: " << cache.getCapacity() << " pairings" << std::endl;
+
+    while (running) {
+        int clientFd = accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) {
+            continue; // woken by stop(), or a client that disconnected during accept
+        }
+
+        reapReaders();
+
+        auto connection = std::make_shared<Connection>(clientFd);
+        auto finished = std::make_shared<std::atomic<bool>>(false);
+        std::lock_guard<std::mutex> lock(readersMutex);
+        readers.push_back({ std::thread([this, connection, finished] {
+            readRequests(connection);
+            *finished = true;
+        }), connection, finished });
+    }
+
+    // Wake any reader still blocked on an idle client, then wait for them
+    {
+        std::lock_guard<std::mutex> lock(readersMutex);
+        for (auto& reader : readers) {
+            if (auto connection = reader.connection.lock()) {
+                shutdown(connection->fd, SHUT_RD);
+            }
+        }
+    }
+    for (auto& reader : readers) {
+        reader.thread.join();
+    }
+
+    close(listenFd);
+    unlink(serverOptions.servePath.c_str());
+    std::cout << "Server stopped | cache hits: " << cache.getHits() << " | cache misses: " << cache.getMisses() << "\n";
+}
+
+// Joins the readers of clients that have disconnected, so a long-running server only holds threads
+// for the clients still connected
+void SimulationServer::reapReaders() {
+    std::lock_guard<std::mutex> lock(readersMutex);
+    std::erase_if(readers, [](Reader& reader) {
+        if (!*reader.finished) {
+            return false;
+        }
+        reader.thread.join();
+        return true;
+    });
+}
+
+void SimulationServer::stop() {
+    running = false;
+    shutdown(listenFd, SHUT_RDWR);
+}
+
+// Splits the stream into lines and queues each request as a job; responses go back as jobs finish
+void SimulationServer::readRequests(std::shared_ptr<Connection> connection) {
+    std::string buffer;
+    char chunk[4096];
+
+    while (true) {
+        ssize_t received = recv(connection->fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            return;
+        }
+        buffer.append(chunk, received);
+
+        size_t newline;
+        while ((newline = buffer.find('\n')) != std::string::npos) {
+            std::string line = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+
+            std::map<std::string, std::string> fields;
+            try {
+                fields = SimpleJson::parseObject(line);
+            }
+            catch (const std::exception& e) {
+                connection->send(errorResponse(e.what()));
+                continue;
+            }
+
+            if (fields["type"] == "shutdown") {
+                connection->send("{\"ok\":true}");
+                stop();
+                return;
+            }
+
+            pool.submit([this, connection, fields] {
+                std::string response = handleRequest(fields);
+                auto id = fields.find("id");
+                if (id != fields.end()) {
+                    // Splice the id in front so clients can match out-of-order responses
+                    response = "{\"id\":" + SimpleJson::quote(id->second) + "," + response.substr(1);
+                }
+                connection->send(response);
+            });
+        }
+    }
+}
+
+#endif
+
+std::string SimulationServer::handleRequest(const std::map<std::string, std::string>& fields) {
+    try {
+        auto type = fields.find("type");
+        if (type == fields.end() || (type->second != "tournament" && type->second != "evolution")) {
+            throw std::invalid_argument("Error - request \"type\" must be tournament, evolution or shutdown");
+        }
+
+        // Reuse the command line validation by rebuilding the equivalent arguments
+        // Each job runs on a single pool thread, as the pool already runs requests side by side
+        std::vector<std::string> args = { serverOptions.executable, "--format", "csv", "--threads", "1" };
+        if (type->second == "evolution") {
+            args.insert(args.end(), { "--evolve", "1" });
+        }
+        for (const auto& field : jobFields) {
+            auto value = fields.find(field);
+            if (value == fields.end() || value->second == "false") {
+                continue;
+            }
+            args.push_back("--" + field);
+            args.push_back(value->second == "true" ? "1" : value->second);
+        }
+
+        std::vector<char*> argv;
+        for (auto& arg : args) {
+            argv.push_back(arg.data());
+        }
+        CommandOptions options = CLIParser::parse(static_cast<int>(argv.size()), argv.data());
+        options.maxMemory = serverOptions.maxMemory; // jobs stop with an error rather than exceed the server's budget
+
+        return options.evolve ? runEvolutionJob(options) : runTournamentJob(options);
+    }
+    catch (const std::exception& e) {
+        return errorResponse(e.what());
+    }
+}
+
+std::string SimulationServer::runTournamentJob(const CommandOptions& options) {
+    auto start = std::chrono::steady_clock::now();
+
+    Payoff<double> payoff(options.t, options.r, options.p, options.s);
+    TournamentManager<double> tournament(options, payoff);
+    tournament.setPairCache(&cache);
+
+    StrategyRegistry registry(options.strategies);
+    StrategyMatrix<MatchStatistics> results = tournament.playRoundRobin(registry);
+
+    std::ostringstream response;
+    response << std::setprecision(12) << "{\"ok\":true,\"pairs\":[";
+    bool first = true;
+    for (StrategyId i = 0; i < registry.size(); ++i) {
+        for (StrategyId j = i; j < registry.size(); ++j) {
+            const MatchStatistics& stats = results.at(i, j);
+            response << (first ? "" : ",")
+                << "{\"p1\":" << SimpleJson::quote(registry.getName(i)) << ",\"p2\":" << SimpleJson::quote(registry.getName(j))
+                << ",\"mean1\":" << stats.p1Mean << ",\"mean2\":" << stats.p2Mean
+                << ",\"stdev1\":" << stats.p1Stdev << ",\"stdev2\":" << stats.p2Stdev << "}";
+            first = false;
+        }
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    response << "],\"elapsedMs\":" << elapsed.count() << "}";
+    return response.str();
+}
+
+std::string SimulationServer::runEvolutionJob(const CommandOptions& options) {
+    auto start = std::chrono::steady_clock::now();
+
+    Payoff<double> payoff(options.t, options.r, options.p, options.s);
+    TournamentManager<double> tournament(options, payoff);
+    tournament.setPairCache(&cache);
+
+    StrategyRoster roster(options.strategies);
+    auto fitnessMatrix = tournament.buildFitnessMatrix(roster);
+    EvolutionaryDynamics dynamics(*fitnessMatrix, EvolutionaryDynamics::parseType(options.dynamics), options.mutation, options.responseRate);
+
+    int gen = 0;
+    while (gen < options.generations && !dynamics.hasConverged()) {
+        dynamics.step();
+        gen++;
+    }
+
+    std::ostringstream response;
+    response << std::setprecision(12) << "{\"ok\":true,\"generations\":" << gen
+        << ",\"converged\":" << (dynamics.hasConverged() ? "true" : "false") << ",\"shares\":{";
+    for (size_t id = 0; id < roster.size(); ++id) {
+        response << (id == 0 ? "" : ",") << SimpleJson::quote(roster.getLabel(id)) << ":" << dynamics.getShares()[id] * 100.0;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    response << "},\"elapsedMs\":" << elapsed.count() << "}";
+    return response.str();
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include "cli_parser.hpp"
+#include "thread_pool.hpp"
+#include "pair_result_cache.hpp"
+
+// Long-running daemon that accepts tournament and evolution jobs as newline-delimited JSON over
+// a local Unix socket. Jobs run on a persistent thread pool and share one cache of pairing results,
+// so repeated or overlapping configurations skip the pairings that were already played.
+//
+// Request:  {"id": "1", "type": "tournament", "rounds": 100, "repeats": 5, "strategies": ["ALLC", "TFT"]}
+//           Fields mirror the command line options (payoff, epsilon, seed, population, generations,
+//           scb, dynamics, mutation, response-rate). "type" is tournament, evolution or shutdown.
+// Response: one JSON object per request on the same connection, echoing "id" when given.
+class SimulationServer {
+public:
+    explicit SimulationServer(const CommandOptions& options);
+    void run(); // blocks until a shutdown request arrives
+
+private:
+    struct Connection {
+        explicit Connection(int fd) : fd(fd) {}
+        ~Connection();
+        void send(const std::string& line);
+
+        int fd;
+        std::mutex writeMutex;
+    };
+
+    const CommandOptions& serverOptions;
+    PairResultCache cache;
+    ThreadPool pool;
+    std::atomic<bool> running{ true };
+    int listenFd = -1;
+
+    // One thread per open client reading its requests
+    struct Reader {
+        std::thread thread;
+        std::weak_ptr<Connection> connection;
+        std::shared_ptr<std::atomic<bool>> finished;
+    };
+
+    std::mutex readersMutex;
+    std::vector<Reader> readers;
+
+    void readRequests(std::shared_ptr<Connection> connection);
+    void reapReaders();
+    std::string handleRequest(const std::map<std::string, std::string>& fields);
+    std::string runTournamentJob(const CommandOptions& options);
+    std::string runEvolutionJob(const CommandOptions& options);
+    void stop();
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include <iostream>
+#include <random>
 #include <string>
+#include <string_view>
 #include "action.hpp"
 
 struct GameState;
@@ -8,8 +10,11 @@ struct GameState;
 class Strategy {
 public:
     virtual Action decideAction(const GameState& state) = 0;
-    virtual std::string name() const = 0;
+    virtual std::string_view name() const = 0;
     virtual ~Strategy() = default; //destructor
+    // Same moves for the same game state every time, with no internal randomness. Repeats between
+    // two deterministic strategies are collapsed into one game, so every strategy has to say.
+    virtual bool isDeterministic() const = 0;
     double getScore() const { return score; }
     void addScore(double s) { score += s; }
     void resetScore() { score = 0; }
@@ -12,7 +12,20 @@
 #include "trojan_strategy.hpp"
 #include "rival_strategy.hpp"
 
-std::unique_ptr<Strategy> StrategyCreator::createStrategy(const std::string& stratName) {
+std::unique_ptr<Strategy> StrategyCreator::createStrategy(const std::string& name) {
+    return create(name, std::nullopt);
+}
+
+std::unique_ptr<Strategy> StrategyCreator::createSeededStrategy(const std::string& name, int seed, int repeat, int seat) {
+    return create(name, RandomStream(seed, repeat, seat));
+}
+
+// Only the random strategies take a stream, and std::random_device is only read when none is given
+std::unique_ptr<Strategy> StrategyCreator::create(const std::string& stratName, std::optional<RandomStream> stream) {
+    auto randomStream = [&stream] {
+        return stream ? *stream : RandomStream(std::random_device{}());
+    };
+
     if (stratName == "ALLC") {
         return std::make_unique<ALLC>();
     }
@@ -35,18 +48,19 @@ std::unique_ptr<Strategy> StrategyCreator::createStrategy(const std::string& str
         return std::make_unique<PROBER>();
     }
     if (stratName == "TROJAN") {
-        return std::make_unique<TROJAN>();
+        return std::make_unique<TROJAN>(randomStream());
     }
     if (stratName == "RIVAL") {
         return std::make_unique<RIVAL>();
     }
 
-    std::regex rndStratPattern(R"(RND([0-9]*\.?[0-9]+))");
+    // Built once, as compiling the pattern costs more than a short game
+    static const std::regex rndStratPattern(R"(RND([0-9]*\.?[0-9]+))");
     std::smatch match;
 
     if (std::regex_match(stratName, match, rndStratPattern)) {
         double probability = std::stod(match[1].str());
         
-        return std::make_unique<RND>(probability);
+        return std::make_unique<RND>(probability, randomStream());
     }
-}
\ No newline at end of file
+}
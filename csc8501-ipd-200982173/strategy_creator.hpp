@@ -2,9 +2,18 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <optional>
 #include "strategy.hpp"
+#include "random_stream.hpp"
 
 class StrategyCreator {
 public:
+    // Random strategies draw their seed from std::random_device
     static std::unique_ptr<Strategy> createStrategy(const std::string& name);
+    // A strategy for one seat (1 or 2) of one repeat, with any internal randomness seeded from
+    // (seed, repeat, seat) so the match can be replayed exactly
+    static std::unique_ptr<Strategy> createSeededStrategy(const std::string& name, int seed, int repeat, int seat);
+
+private:
+    static std::unique_ptr<Strategy> create(const std::string& name, std::optional<RandomStream> stream);
 };
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+
+// Dense N x N matrix indexed by strategy id, stored row-major in one contiguous block
+template <typename V>
+class StrategyMatrix {
+public:
+    explicit StrategyMatrix(size_t size = 0, const V& initial = V{});
+
+    V& at(size_t row, size_t column) { return cells[row * n + column]; }
+    const V& at(size_t row, size_t column) const { return cells[row * n + column]; }
+    const V* row(size_t r) const { return cells.data() + r * n; }
+    size_t size() const { return n; }
+
+    // out = M * x
+    void multiply(const std::vector<V>& x, std::vector<V>& out) const requires std::is_arithmetic_v<V>;
+
+private:
+    size_t n;
+    std::vector<V> cells;
+};
+
+#include "strategy_matrix.tpp"
@@ -0,0 +1,55 @@
+#pragma once
+
+template <typename V>
+StrategyMatrix<V>::StrategyMatrix(size_t size, const V& initial)
+    : n(size), cells(size * size, initial) {}
+
+// Register-blocked row-major matrix-vector product in the style of a BLAS gemv kernel.
+// Four rows are processed together so every x[c] is loaded once per block, and each row keeps
+// two independent accumulators so the inner loop has no serial dependency and can be vectorised
+// without relaxed floating point.
+template <typename V>
+void StrategyMatrix<V>::multiply(const std::vector<V>& x, std::vector<V>& out) const requires std::is_arithmetic_v<V> {
+    out.assign(n, V{});
+    const V* xValues = x.data();
+    size_t r = 0;
+
+    for (; r + 4 <= n; r += 4) {
+        const V* row0 = row(r);
+        const V* row1 = row0 + n;
+        const V* row2 = row1 + n;
+        const V* row3 = row2 + n;
+        V sum0a{}, sum0b{}, sum1a{}, sum1b{}, sum2a{}, sum2b{}, sum3a{}, sum3b{};
+        size_t c = 0;
+
+        for (; c + 2 <= n; c += 2) {
+            V x0 = xValues[c];
+            V x1 = xValues[c + 1];
+            sum0a += row0[c] * x0; sum0b += row0[c + 1] * x1;
+            sum1a += row1[c] * x0; sum1b += row1[c + 1] * x1;
+            sum2a += row2[c] * x0; sum2b += row2[c + 1] * x1;
+            sum3a += row3[c] * x0; sum3b += row3[c + 1] * x1;
+        }
+        if (c < n) {
+            sum0a += row0[c] * xValues[c];
+            sum1a += row1[c] * xValues[c];
+            sum2a += row2[c] * xValues[c];
+            sum3a += row3[c] * xValues[c];
+        }
+
+        out[r] = sum0a + sum0b;
+        out[r + 1] = sum1a + sum1b;
+        out[r + 2] = sum2a + sum2b;
+        out[r + 3] = sum3a + sum3b;
+    }
+
+    // Remaining rows when n is not a multiple of four
+    for (; r < n; ++r) {
+        const V* rowValues = row(r);
+        V sum{};
+        for (size_t c = 0; c < n; ++c) {
+            sum += rowValues[c] * xValues[c];
+        }
+        out[r] = sum;
+    }
+}
@@ -0,0 +1,44 @@
+#include <stdexcept>
+#include "strategy_registry.hpp"
+
+StrategyRegistry::StrategyRegistry(const std::vector<std::string>& names) {
+    for (const auto& name : names) {
+        intern(name);
+    }
+}
+
+// Returns the existing id for a name, or assigns the next free id
+StrategyId StrategyRegistry::intern(const std::string& name) {
+    auto iterator = ids.find(name);
+    if (iterator != ids.end()) {
+        return iterator->second;
+    }
+
+    StrategyId id = static_cast<StrategyId>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+StrategyId StrategyRegistry::getId(const std::string& name) const {
+    auto iterator = ids.find(name);
+    if (iterator == ids.end()) {
+        throw std::invalid_argument("Error - strategy not registered: " + name);
+    }
+    return iterator->second;
+}
+
+StrategyRoster::StrategyRoster(const std::vector<std::string>& names) {
+    std::vector<int> copies;
+
+    for (const auto& name : names) {
+        StrategyId id = registry.intern(name);
+        if (id >= copies.size()) {
+            copies.resize(id + 1, 0);
+        }
+        copies[id]++;
+
+        ids.push_back(id);
+        labels.push_back(copies[id] == 1 ? name : name + "#" + std::to_string(copies[id]));
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using StrategyId = std::uint32_t;
+
+// Interns strategy names into small dense ids so results can be stored in flat arrays
+class StrategyRegistry {
+public:
+    StrategyRegistry() = default;
+    explicit StrategyRegistry(const std::vector<std::string>& names);
+
+    StrategyId intern(const std::string& name);
+    StrategyId getId(const std::string& name) const;
+    const std::string& getName(StrategyId id) const { return names[id]; }
+    const std::vector<std::string>& getNames() const { return names; }
+    size_t size() const { return names.size(); }
+
+private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, StrategyId> ids;
+};
+
+// The strategy list as entered, in order. A name given more than once becomes a separate instance
+// (TFT, TFT#2, TFT#3) that shares its registry id, so duplicates never cause extra simulation.
+class StrategyRoster {
+public:
+    explicit StrategyRoster(const std::vector<std::string>& names);
+
+    const StrategyRegistry& getRegistry() const { return registry; }
+    StrategyId getId(size_t instance) const { return ids[instance]; }
+    const std::string& getLabel(size_t instance) const { return labels[instance]; }
+    const std::vector<std::string>& getLabels() const { return labels; }
+    size_t size() const { return ids.size(); }
+
+private:
+    StrategyRegistry registry;
+    std::vector<StrategyId> ids;
+    std::vector<std::string> labels;
+};
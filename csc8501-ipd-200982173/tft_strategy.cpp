@@ -9,6 +9,6 @@ Action TFT::decideAction(const GameState& state) {
     return state.lastOpponentMove;
 }
 
-std::string TFT::name() const {
+std::string_view TFT::name() const {
     return "TFT";
 }
\ No newline at end of file
@@ -4,5 +4,6 @@
 class TFT : public Strategy {
 public:
     Action decideAction(const GameState& state) override;
-    std::string name() const override;
+    std::string_view name() const override;
+    bool isDeterministic() const override { return true; }
 };
\ No newline at end of file
@@ -1,19 +1,29 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <map>
+#include <memory>
+#include <cstdint>
+#include <fstream>
 #include "cli_parser.hpp"
 #include "payoff.hpp"
+#include "strategy_registry.hpp"
+#include "strategy_matrix.hpp"
+#include "score_accumulator.hpp"
+#include "sharding.hpp"
+#include "pair_result_cache.hpp"
+#include "round_metrics.hpp"
+#include "strategy.hpp"
 
 struct MatchStatistics {
     double p1Mean;
     double p2Mean;
     double p1Stdev;
     double p2Stdev;
-    std::string p1CILower;
-    std::string p1CIUpper;
-    std::string p2CILower;
-    std::string p2CIUpper;
+    // 95% confidence interval bounds, NaN when there are too few repeats for one
+    double p1CILower;
+    double p1CIUpper;
+    double p2CILower;
+    double p2CIUpper;
 };
 
 template <typename T>
@@ -22,23 +32,62 @@ public:
     TournamentManager(const CommandOptions& options, const Payoff<T>& payoff);
     void runTournament();
     void runEvolutionaryTournament();
+    void replayMatch(int repetition);
+
+    // Results of every pairing, without writing any result files. Per-round metrics are collected
+    // into the given matrix when one is passed.
+    StrategyMatrix<MatchStatistics> playRoundRobin(const StrategyRegistry& registry, StrategyMatrix<TournamentMetrics>* metrics = nullptr);
+    std::shared_ptr<const StrategyMatrix<double>> buildFitnessMatrix(const StrategyRoster& roster);
+    // Partial results of one shard of the round robin, as a --shard worker computes them
+    std::vector<PairResult> playShard(const StrategyRegistry& registry, int shard, int shardCount);
+
+    // Full pairings are looked up in, and added to, a cache shared with other tournaments
+    void setPairCache(PairResultCache* cache) { pairCache = cache; }
+
 private:
     const CommandOptions& options;
     const Payoff<T>& payoff;
+    PairResultCache* pairCache = nullptr;
+
+    static constexpr const char* evolutionaryLeaderboardFilename = "evolutionary_leaderboard.csv";
 
-    std::pair<std::vector<double>, std::vector<double>> runIPD(const std::string& strat1, const std::string& strat2);
+    std::pair<ScoreAccumulator, ScoreAccumulator> runIPD(const std::string& strat1, const std::string& strat2, int repeatBegin, int repeatEnd);
+    template <typename Metrics>
+    std::pair<ScoreAccumulator, ScoreAccumulator> playRepeats(const std::string& strat1, const std::string& strat2, int repeatBegin, int repeatEnd, Metrics& metrics);
+    std::string pairCacheKey(const std::string& strat1, const std::string& strat2) const;
+    std::vector<std::pair<StrategyId, StrategyId>> tournamentPairs(const StrategyRegistry& registry) const;
+    bool repeatsAreIdentical(const Strategy& p1Strategy, const Strategy& p2Strategy) const;
+    double decisionCost(const std::string& name) const;
+    double estimateRepeatCost(const std::string& strat1, const std::string& strat2) const;
+    std::vector<PairResult> runScheduled(const StrategyRegistry& registry, const std::vector<std::pair<StrategyId, StrategyId>>& pairs, bool splitRepeats, StrategyMatrix<TournamentMetrics>* metrics = nullptr);
+    std::vector<PairResult> runTasks(const StrategyRegistry& registry, const std::vector<std::pair<StrategyId, StrategyId>>& pairs, ShardTaskRange range, StrategyMatrix<TournamentMetrics>* metrics = nullptr);
     std::string createFilename(const std::string& prefix, const std::string& extension = ".csv") const;
     std::ofstream openPairwisePayoffsFile(std::string& outFilename) const;
     
+    MatchStatistics calculateStatistics(const ScoreAccumulator& p1Scores, const ScoreAccumulator& p2Scores) const;
     MatchStatistics calculateStatistics(const std::vector<double>& p1Scores, const std::vector<double>& p2Scores) const;
 
+    std::string formatCIBound(double bound) const;
+
+    double scbCost(const std::string& name) const;
+
+    // Rough size of the largest allocations of a run, checked against --max-memory
+    std::uint64_t estimateTournamentBytes(size_t strategyCount, size_t pairCount) const;
+    std::uint64_t estimateEvolutionBytes(size_t strategyCount, size_t instanceCount) const;
+    std::uint64_t estimatePairingBytes(size_t pairCount) const;
+    static std::uint64_t schedulerJobBytes();
+
     void outputPairwisePayoffsStats(const std::string& strat1, const std::string& strat2, const MatchStatistics& stats) const;
-    void writePairwisePayoffsFile(const std::map<std::pair<std::string, std::string>, MatchStatistics>& allResults) const;
-    void writePayoffMatrixFile(const std::vector<std::string>& strategies, const std::map<std::pair<std::string, std::string>, MatchStatistics>& results) const;
-    void writeLeaderboardFile(const std::vector<std::string>& strategies, const std::map<std::pair<std::string, std::string>, MatchStatistics>& results) const;
-    void writeEvolutionaryResultsFile(const std::vector<std::string>& strategies, const std::vector<std::map<std::string, double>>& populationHistory,
-        const std::map<std::pair<std::string, std::string>, MatchStatistics>& finalResults) const;
-    void writeEvolutionaryLeaderboardFile(const std::map<std::string, double>& finalPopulationShares) const;
+    void writePairwisePayoffsFile(const StrategyRoster& roster, const StrategyMatrix<MatchStatistics>& allResults) const;
+    void writePayoffMatrixFile(const StrategyRoster& roster, const StrategyMatrix<MatchStatistics>& results) const;
+    void writeLeaderboardFile(const StrategyRoster& roster, const StrategyMatrix<MatchStatistics>& results) const;
+    void writeRoundMetricsFile(const StrategyRoster& roster, const StrategyMatrix<TournamentMetrics>& metrics) const;
+    void writeCooperationSeriesFile(const StrategyRoster& roster, const StrategyMatrix<TournamentMetrics>& metrics) const;
+    std::ofstream openEvolutionaryResultsFile(const StrategyRoster& roster, std::string& outFilename) const;
+    std::ofstream reopenEvolutionaryResultsFile(const std::string& filename, std::uint64_t validBytes) const;
+    void appendEvolutionaryResultsRow(std::ofstream& csv, int generation, const std::vector<double>& population) const;
+    std::string readEvolutionaryLeaderboardFile() const;
+    void writeEvolutionaryLeaderboardFile(const StrategyRoster& roster, const std::vector<double>& finalPopulationShares, const std::string& previousLeaderboard) const;
 };
 
 #include "tournament_manager.tpp"
\ No newline at end of file
@@ -7,14 +7,52 @@
 #include <map>
 #include <algorithm>
 #include <numeric>
+#include <filesystem>
+#include <limits>
+#include <tuple>
 #include "game_manager.hpp"
 #include "strategy_creator.hpp"
+#include "evolutionary_dynamics.hpp"
+#include "checkpoint.hpp"
+#include "sharding.hpp"
+#include "random_stream.hpp"
+#include "memory_budget.hpp"
+#include "pair_scheduler.hpp"
 
 template <typename T>
 TournamentManager<T>::TournamentManager(const CommandOptions& options, const Payoff<T>& payoff)
     : options(options), payoff(payoff) {
 }
 
+template <typename T>
+MatchStatistics TournamentManager<T>::calculateStatistics(const ScoreAccumulator& p1Scores, const ScoreAccumulator& p2Scores) const {
+    MatchStatistics stats;
+
+    stats.p1Mean = p1Scores.getMean();
+    stats.p2Mean = p2Scores.getMean();
+    stats.p1Stdev = p1Scores.getStdev();
+    stats.p2Stdev = p2Scores.getStdev();
+
+    // Calculate Confidence Interval 
+    if (p1Scores.getCount() > 1) {
+        double p1CiRange = 1.96 * stats.p1Stdev / std::sqrt(static_cast<double>(p1Scores.getCount()));
+        double p2CiRange = 1.96 * stats.p2Stdev / std::sqrt(static_cast<double>(p2Scores.getCount()));
+
+        stats.p1CILower = stats.p1Mean - p1CiRange;
+        stats.p1CIUpper = stats.p1Mean + p1CiRange;
+        stats.p2CILower = stats.p2Mean - p2CiRange;
+        stats.p2CIUpper = stats.p2Mean + p2CiRange;
+    }
+    else {
+        stats.p1CILower = std::numeric_limits<double>::quiet_NaN();
+        stats.p1CIUpper = std::numeric_limits<double>::quiet_NaN();
+        stats.p2CILower = std::numeric_limits<double>::quiet_NaN();
+        stats.p2CIUpper = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    return stats;
+}
+
 template <typename T>
 MatchStatistics TournamentManager<T>::calculateStatistics(const std::vector<double>& p1Scores, const std::vector<double>& p2Scores) const {
     MatchStatistics stats;
@@ -56,21 +94,27 @@ MatchStatistics TournamentManager<T>::calculateStatistics(const std::vector<doub
         double p1CiRange = 1.96 * p1StandardError;
         double p2CiRange = 1.96 * p2StandardError;
 
-        stats.p1CILower = std::to_string(stats.p1Mean - p1CiRange);
-        stats.p1CIUpper = std::to_string(stats.p1Mean + p1CiRange);
-        stats.p2CILower = std::to_string(stats.p2Mean - p2CiRange);
-        stats.p2CIUpper = std::to_string(stats.p2Mean + p2CiRange);
+        stats.p1CILower = stats.p1Mean - p1CiRange;
+        stats.p1CIUpper = stats.p1Mean + p1CiRange;
+        stats.p2CILower = stats.p2Mean - p2CiRange;
+        stats.p2CIUpper = stats.p2Mean + p2CiRange;
     }
     else {
-        stats.p1CILower = "N/A";
-        stats.p1CIUpper = "N/A";
-        stats.p2CILower = "N/A";
-        stats.p2CIUpper = "N/A";
+        stats.p1CILower = std::numeric_limits<double>::quiet_NaN();
+        stats.p1CIUpper = std::numeric_limits<double>::quiet_NaN();
+        stats.p2CILower = std::numeric_limits<double>::quiet_NaN();
+        stats.p2CIUpper = std::numeric_limits<double>::quiet_NaN();
     }
 
     return stats;
 }
 
+// Bounds are kept as numbers and only turned into text for output
+template <typename T>
+std::string TournamentManager<T>::formatCIBound(double bound) const {
+    return std::isnan(bound) ? "N/A" : std::to_string(bound);
+}
+
 template <typename T>
 std::string TournamentManager<T>::createFilename(const std::string& prefix, const std::string& extension) const {
     auto systemTime = std::chrono::system_clock::now();
@@ -105,13 +149,13 @@ void TournamentManager<T>::outputPairwisePayoffsStats(const std::string& strat1,
 	// Console output
 	std::cout << "\n---------CONFIDENCE INTERVAL---------";
     std::cout << "\n" << strat1 << " vs " << strat2 << ":\n";
-    std::cout << " Player 1 (" << strat1 << ") Mean = " << stats.p1Mean << ", 95% CI [" << stats.p1CILower << ", " << stats.p1CIUpper << "]\n";
-    std::cout << " Player 2 (" << strat2 << ") Mean = " << stats.p2Mean << ", 95% CI [" << stats.p2CILower << ", " << stats.p2CIUpper << "]\n";
+    std::cout << " Player 1 (" << strat1 << ") Mean = " << stats.p1Mean << ", 95% CI [" << formatCIBound(stats.p1CILower) << ", " << formatCIBound(stats.p1CIUpper) << "]\n";
+    std::cout << " Player 2 (" << strat2 << ") Mean = " << stats.p2Mean << ", 95% CI [" << formatCIBound(stats.p2CILower) << ", " << formatCIBound(stats.p2CIUpper) << "]\n";
     std::cout << "==========================================================================================\n";
 }
 
 template <typename T>
-void TournamentManager<T>::writePairwisePayoffsFile(const std::map<std::pair<std::string, std::string>, MatchStatistics>& allResults) const {
+void TournamentManager<T>::writePairwisePayoffsFile(const StrategyRoster& roster, const StrategyMatrix<MatchStatistics>& allResults) const {
     std::string filename = createFilename("pairwise_payoffs");
     
     std::ofstream csv(filename);
@@ -124,16 +168,26 @@ void TournamentManager<T>::writePairwisePayoffsFile(const std::map<std::pair<std
     csv << "Payoff: " << payoff.getT() << "," << payoff.getR() << "," << payoff.getP() << "," << payoff.getS() << "\n\n\n";
     csv << "Strategy[1],Strategy[2],Mean[1],Mean[2],Stdev[1],Stdev[2],CI_Low[1],CI_Up[1],CI_Low[2],CI_Up[2]\n";
 
-    for (const auto& [pair, stats] : allResults) {
-        const std::string& strat1 = pair.first;
-        const std::string& strat2 = pair.second;
-        
+    // Rows are sorted by strategy names, as they were when results were keyed by name
+    std::vector<std::pair<size_t, size_t>> rows;
+    for (size_t i = 0; i < roster.size(); ++i) {
+        for (size_t j = 0; j < roster.size(); ++j) {
+            rows.push_back({ i, j });
+        }
+    }
+    std::sort(rows.begin(), rows.end(), [&](const auto& a, const auto& b) {
+        return std::tie(roster.getLabel(a.first), roster.getLabel(a.second)) < std::tie(roster.getLabel(b.first), roster.getLabel(b.second));
+    });
+
+    for (auto [i, j] : rows) {
+        const MatchStatistics& stats = allResults.at(roster.getId(i), roster.getId(j));
+
         // CSV output
-        csv << strat1 << "," << strat2 << ","
+        csv << roster.getLabel(i) << "," << roster.getLabel(j) << ","
             << stats.p1Mean << "," << stats.p2Mean << ","
             << stats.p1Stdev << "," << stats.p2Stdev << ","
-            << stats.p1CILower << "," << stats.p1CIUpper << ","
-            << stats.p2CILower << "," << stats.p2CIUpper << "\n";
+            << formatCIBound(stats.p1CILower) << "," << formatCIBound(stats.p1CIUpper) << ","
+            << formatCIBound(stats.p2CILower) << "," << formatCIBound(stats.p2CIUpper) << "\n";
     }
 
     csv.close();
@@ -141,7 +195,7 @@ void TournamentManager<T>::writePairwisePayoffsFile(const std::map<std::pair<std
 }
 
 template <typename T>
-void TournamentManager<T>::writePayoffMatrixFile(const std::vector<std::string>& strategies, const std::map<std::pair<std::string, std::string>, MatchStatistics>& results) const {
+void TournamentManager<T>::writePayoffMatrixFile(const StrategyRoster& roster, const StrategyMatrix<MatchStatistics>& results) const {
     std::string filename = createFilename("payoff_matrix");
     std::ofstream payoffMatrixFile(filename);
 
@@ -151,29 +205,17 @@ void TournamentManager<T>::writePayoffMatrixFile(const std::vector<std::string>&
 
     // Headers/lables/top row
     payoffMatrixFile << ",";
-    for (const auto& strat : strategies) {
+    for (const auto& strat : roster.getLabels()) {
         payoffMatrixFile << strat << ",";
     }
     payoffMatrixFile << "\n";
 
-    for (const auto& rowStrat : strategies) {
-        payoffMatrixFile << rowStrat << ",";
+    for (size_t row = 0; row < roster.size(); ++row) {
+        payoffMatrixFile << roster.getLabel(row) << ",";
 
-        for (const auto& columnStrat : strategies) {
-			// Strategies do not play against themselves so mark with "-"
-            if (rowStrat == columnStrat) {
-                payoffMatrixFile << "-,";
-            }
-            else {
-                auto mapIterator = results.find({ rowStrat, columnStrat });
-                
-                if (mapIterator != results.end()) {
-                    payoffMatrixFile << mapIterator->second.p1Mean << ",";
-                }
-                else {
-                    payoffMatrixFile << "N/A,";
-                }
-            }
+        // The diagonal is each strategy's self-play payoff
+        for (size_t column = 0; column < roster.size(); ++column) {
+            payoffMatrixFile << results.at(roster.getId(row), roster.getId(column)).p1Mean << ",";
         }
         payoffMatrixFile << "\n";
     }
@@ -184,17 +226,21 @@ void TournamentManager<T>::writePayoffMatrixFile(const std::vector<std::string>&
 }
 
 template <typename T>
-void TournamentManager<T>::writeLeaderboardFile(const std::vector<std::string>& strategies, const std::map<std::pair<std::string, std::string>, MatchStatistics>& results) const {
+void TournamentManager<T>::writeLeaderboardFile(const StrategyRoster& roster, const StrategyMatrix<MatchStatistics>& results) const {
     std::string filename = "leaderboard.csv";
-
-    std::map<std::string, std::vector<double>> strategyScores;
-
-    for (const auto& [pair, stats] : results) {
-        const std::string& strat1 = pair.first;
-        const std::string& strat2 = pair.second;
-
-        strategyScores[strat1].push_back(stats.p1Mean);
-        strategyScores[strat2].push_back(stats.p2Mean);
+    const StrategyRegistry& registry = roster.getRegistry();
+
+    // Each ordered pair of instances, self-play included, contributes the row strategy's mean and the
+    // column strategy's mean. Duplicate instances are scored under their shared strategy name.
+    std::vector<std::vector<double>> strategyScores(registry.size());
+
+    for (size_t i = 0; i < roster.size(); ++i) {
+        for (size_t j = 0; j < roster.size(); ++j) {
+            StrategyId row = roster.getId(i);
+            StrategyId column = roster.getId(j);
+            strategyScores[row].push_back(results.at(row, column).p1Mean);
+            strategyScores[column].push_back(results.at(row, column).p2Mean);
+        }
     }
 
     struct LeaderboardEntry {
@@ -206,9 +252,9 @@ void TournamentManager<T>::writeLeaderboardFile(const std::vector<std::string>&
 
     std::vector<LeaderboardEntry> currentLeaderboard;
 
-    for (const auto& [strat, scores] : strategyScores) {
-        MatchStatistics stats = calculateStatistics(scores, {});
-        currentLeaderboard.push_back({ strat, stats.p1Mean, stats.p1Stdev });
+    for (StrategyId id = 0; id < registry.size(); ++id) {
+        MatchStatistics stats = calculateStatistics(strategyScores[id], {});
+        currentLeaderboard.push_back({ registry.getName(id), stats.p1Mean, stats.p1Stdev });
     }
 
     // Load existing leaderboard if it exists
@@ -283,67 +329,434 @@ void TournamentManager<T>::writeLeaderboardFile(const std::vector<std::string>&
 }
 
 template <typename T>
-std::pair<std::vector<double>, std::vector<double>> TournamentManager<T>::runIPD(const std::string& strat1, const std::string& strat2) {
-    std::vector<double> p1Scores;
-    std::vector<double> p2Scores;
+void TournamentManager<T>::writeRoundMetricsFile(const StrategyRoster& roster, const StrategyMatrix<TournamentMetrics>& metrics) const {
+    std::string filename = createFilename("round_metrics");
 
-    // Single random number generator for the whole tournament
-    std::mt19937 randNumGen(options.seed);
+    std::ofstream csv(filename);
+    if (!csv.is_open()) {
+        throw std::runtime_error("Round metrics file " + filename + " could not be created");
+    }
+
+    csv << "Strategy[1],Strategy[2]";
+    TournamentMetrics::writeHeader(csv);
+    csv << "\n";
 
-    for (int r = 0; r < options.repeats; ++r) {
-        auto p1Strategy = StrategyCreator::createStrategy(strat1);
-        auto p2Strategy = StrategyCreator::createStrategy(strat2);
+    for (size_t i = 0; i < roster.size(); ++i) {
+        for (size_t j = 0; j < roster.size(); ++j) {
+            csv << roster.getLabel(i) << "," << roster.getLabel(j);
+            metrics.at(roster.getId(i), roster.getId(j)).writeValues(csv);
+            csv << "\n";
+        }
+    }
+
+    csv.close();
+    std::cout << "\n- Round metrics saved in: " << filename;
+}
+
+// One row per round of every pairing: the share of repeats in which each player cooperated
+template <typename T>
+void TournamentManager<T>::writeCooperationSeriesFile(const StrategyRoster& roster, const StrategyMatrix<TournamentMetrics>& metrics) const {
+    std::string filename = createFilename("cooperation_series");
+
+    std::ofstream csv(filename);
+    if (!csv.is_open()) {
+        throw std::runtime_error("Cooperation series file " + filename + " could not be created");
+    }
+
+    csv << "Strategy[1],Strategy[2],Round,CoopRate[1],CoopRate[2]\n";
+
+    for (size_t i = 0; i < roster.size(); ++i) {
+        for (size_t j = 0; j < roster.size(); ++j) {
+            const CooperationRate& series = metrics.at(roster.getId(i), roster.getId(j));
+            for (int round = 1; round <= static_cast<int>(series.getRounds()); ++round) {
+                csv << roster.getLabel(i) << "," << roster.getLabel(j) << "," << round << ","
+                    << series.getP1Rate(round) << "," << series.getP2Rate(round) << "\n";
+            }
+        }
+    }
+
+    csv.close();
+    std::cout << "\n- Cooperation series saved in: " << filename;
+}
+
+// Plays repeats [repeatBegin, repeatEnd) of one pairing. Every repeat draws its noise from its own
+// stream seeded by (seed, repeat), so any subset of repeats can run in any process or order.
+template <typename T>
+std::pair<ScoreAccumulator, ScoreAccumulator> TournamentManager<T>::runIPD(const std::string& strat1, const std::string& strat2, int repeatBegin, int repeatEnd) {
+    NoMetrics metrics;
+    if (!pairCache || repeatBegin != 0 || repeatEnd != options.repeats) {
+        return playRepeats(strat1, strat2, repeatBegin, repeatEnd, metrics);
+    }
+
+    bool wasCached = false;
+    return pairCache->getOrCompute(pairCacheKey(strat1, strat2), [&] {
+        return playRepeats(strat1, strat2, repeatBegin, repeatEnd, metrics);
+    }, wasCached);
+}
+
+// Every option that changes the outcome of a single pairing
+template <typename T>
+std::string TournamentManager<T>::pairCacheKey(const std::string& strat1, const std::string& strat2) const {
+    std::ostringstream key;
+    key.precision(17);
+    key << strat1 << "|" << strat2 << "|" << options.rounds << "|" << options.repeats << "|"
+        << payoff.getT() << "," << payoff.getR() << "," << payoff.getP() << "," << payoff.getS() << "|";
+    if (options.noiseOn) {
+        key << options.epsilon << "|" << options.seed;
+    }
+    return key.str();
+}
+
+template <typename T>
+template <typename Metrics>
+std::pair<ScoreAccumulator, ScoreAccumulator> TournamentManager<T>::playRepeats(const std::string& strat1, const std::string& strat2, int repeatBegin, int repeatEnd, Metrics& metrics) {
+    ScoreAccumulator p1Scores;
+    ScoreAccumulator p2Scores;
+
+    // One noise engine for the block, moved to each repeat's own stream only when noise is on, as
+    // nothing draws from it otherwise
+    RandomStream randNumGen;
+
+    for (int r = repeatBegin; r < repeatEnd; ++r) {
+        if (options.noiseOn) {
+            randNumGen.reset(options.seed, r, RandomStream::noiseSeat);
+        }
+
+        auto p1Strategy = StrategyCreator::createSeededStrategy(strat1, options.seed, r, 1);
+        auto p2Strategy = StrategyCreator::createSeededStrategy(strat2, options.seed, r, 2);
+
+        bool identicalRepeats = repeatsAreIdentical(*p1Strategy, *p2Strategy);
 
         GameManager<T> game(std::move(p1Strategy), std::move(p2Strategy), payoff, options.epsilon, randNumGen, options.noiseOn, options.format);
-        game.runGame(options.rounds, r + 1, options.repeats);
 
-        p1Scores.push_back(game.getPlayer1Strategy()->getScore());
-        p2Scores.push_back(game.getPlayer2Strategy()->getScore());
+        if (!identicalRepeats) {
+            game.runGame(options.rounds, r + 1, options.repeats, metrics);
+            p1Scores.add(game.getPlayer1Strategy()->getScore());
+            p2Scores.add(game.getPlayer2Strategy()->getScore());
+            continue;
+        }
+
+        Metrics gameMetrics;
+        game.runGame(options.rounds, r + 1, options.repeats, gameMetrics);
+        for (int rest = r; rest < repeatEnd; ++rest) {
+            metrics.merge(gameMetrics);
+            p1Scores.add(game.getPlayer1Strategy()->getScore());
+            p2Scores.add(game.getPlayer2Strategy()->getScore());
+        }
+        break;
     }
 
     return { p1Scores, p2Scores };
 }
 
+// Without noise two deterministic strategies replay the same game every repeat, so one game
+// stands in for all of them. Text output still shows every repeat's rounds.
 template <typename T>
-void TournamentManager<T>::runTournament() {
-    std::vector<std::string> stratList = options.strategies;
-    std::map<std::pair<std::string, std::string>, MatchStatistics> allResults;
+bool TournamentManager<T>::repeatsAreIdentical(const Strategy& p1Strategy, const Strategy& p2Strategy) const {
+    return !options.noiseOn && options.format != "text" && p1Strategy.isDeterministic() && p2Strategy.isDeterministic();
+}
 
-    std::cout << "=====RUNNING IPD TOURNAMENT=====: " << options.rounds << " rounds | " << options.repeats << " repeats | ";
+// Extra cost a strategy adds to each round, relative to one round of ALLC vs ALLC without noise.
+// Measured per round of 200-round games against ALLC (g++ -O2, x86-64), where a plain round takes
+// about 40 ns: RND about +1.0 (a draw every round), TROJAN +0.9 (a draw per game and a growing
+// opponent history), PROBER +0.25 and RIVAL +0.15 (score and history checks), and ALLD, TFT, GRIM,
+// PAVLOV and CTFT within measurement noise of ALLC.
+template <typename T>
+double TournamentManager<T>::decisionCost(const std::string& name) const {
+    if (name.starts_with("RND")) {
+        return 1.0;
+    }
+    if (name == "TROJAN") {
+        return 0.9;
+    }
+    if (name == "PROBER") {
+        return 0.25;
+    }
+    if (name == "RIVAL") {
+        return 0.15;
+    }
+    return 0.0;
+}
+
+// Static model of the cost of one repeat of a pairing, in the units of decisionCost. Noise adds
+// about 1.5 rounds' worth for its two draws and the per-seat checks. Nothing is played to estimate
+// it, so scheduling adds no serial work before the pool starts.
+template <typename T>
+double TournamentManager<T>::estimateRepeatCost(const std::string& strat1, const std::string& strat2) const {
+    constexpr double plainRoundCost = 1.0;
+    constexpr double noiseRoundCost = 1.5;
+    double roundCost = plainRoundCost + decisionCost(strat1) + decisionCost(strat2) + (options.noiseOn ? noiseRoundCost : 0.0);
+    return roundCost * options.rounds;
+}
+
+// Runs the given pairings across options.threads workers. Each pairing's cost comes from a static
+// model, and when there are too few pairings to go round, pairings are also split into blocks of
+// repeats. The blocks depend only on the thread count, and results are merged in job order, so a
+// run is reproducible for a given --threads.
+template <typename T>
+std::vector<PairResult> TournamentManager<T>::runScheduled(const StrategyRegistry& registry, const std::vector<std::pair<StrategyId, StrategyId>>& pairs, bool splitRepeats, StrategyMatrix<TournamentMetrics>* metrics) {
+    ShardTaskRange allTasks{ 0, pairs.size() * options.repeats };
+
+    // Text output follows the order games are played in, so it stays on one thread
+    if (options.format == "text" || options.threads <= 1 || pairs.empty()) {
+        return runTasks(registry, pairs, allTasks, metrics);
+    }
+
+    constexpr size_t jobsPerThread = 8;
+    size_t repeatBlocks = 1;
+    if (splitRepeats) {
+        size_t wanted = (jobsPerThread * options.threads + pairs.size() - 1) / pairs.size();
+        repeatBlocks = std::clamp<size_t>(wanted, 1, options.repeats);
+    }
+
+    // Fewer, larger blocks when the job bookkeeping would not fit in what is left of --max-memory
+    if (options.maxMemory > 0 && repeatBlocks > 1) {
+        std::uint64_t affordableJobs = MemoryBudget(options.maxMemory).remainingBytes() / schedulerJobBytes();
+        repeatBlocks = std::clamp<std::uint64_t>(affordableJobs / pairs.size(), 1, repeatBlocks);
+    }
+
+    // One instance per strategy, to ask whether a pairing plays the same game every repeat
+    std::vector<std::unique_ptr<Strategy>> strategies;
+    for (StrategyId id = 0; id < registry.size(); ++id) {
+        strategies.push_back(StrategyCreator::createStrategy(registry.getName(id)));
+    }
+
+    std::vector<ShardTaskRange> jobs;
+    std::vector<double> costs;
+    for (size_t pair = 0; pair < pairs.size(); ++pair) {
+        auto [p1, p2] = pairs[pair];
+        double repeatCost = estimateRepeatCost(registry.getName(p1), registry.getName(p2));
+        bool identicalRepeats = repeatsAreIdentical(*strategies[p1], *strategies[p2]);
+        size_t blocks = identicalRepeats ? 1 : repeatBlocks;
+
+        for (size_t block = 0; block < blocks; ++block) {
+            size_t begin = block * options.repeats / blocks;
+            size_t end = (block + 1) * options.repeats / blocks;
+            jobs.push_back({ pair * options.repeats + begin, pair * options.repeats + end });
+            costs.push_back(identicalRepeats ? repeatCost : repeatCost * (end - begin));
+        }
+    }
+
+    std::vector<std::vector<PairResult>> jobResults(jobs.size());
+    PairScheduler scheduler(options.threads);
+    scheduler.run(costs, [&](size_t job) {
+        jobResults[job] = runTasks(registry, pairs, jobs[job], metrics);
+    });
+    scheduler.printReport(std::cout);
+
+    std::vector<PairResult> results;
+    for (const auto& jobResult : jobResults) {
+        results.insert(results.end(), jobResult.begin(), jobResult.end());
+    }
+    return results;
+}
+
+// Unordered pairings of the round-robin, self-play included, in the order they are played.
+// Each pairing is played once and mirrored for the reverse seating.
+template <typename T>
+std::vector<std::pair<StrategyId, StrategyId>> TournamentManager<T>::tournamentPairs(const StrategyRegistry& registry) const {
+    std::vector<std::pair<StrategyId, StrategyId>> pairs;
+    for (StrategyId i = 0; i < registry.size(); ++i) {
+        for (StrategyId j = i; j < registry.size(); ++j) {
+            pairs.push_back({ i, j });
+        }
+    }
+    return pairs;
+}
+
+// Runs a block of the flattened (pair, repeat) task space, where task t is repeat t % repeats of
+// pair t / repeats. Consecutive repeats of the same pair are folded into one PairResult.
+template <typename T>
+std::vector<PairResult> TournamentManager<T>::runTasks(const StrategyRegistry& registry, const std::vector<std::pair<StrategyId, StrategyId>>& pairs, ShardTaskRange range, StrategyMatrix<TournamentMetrics>* metrics) {
+    std::vector<PairResult> results;
+    size_t task = range.begin;
+
+    while (task < range.end) {
+        size_t pairIndex = task / options.repeats;
+        int repeatBegin = static_cast<int>(task % options.repeats);
+        int repeatEnd = static_cast<int>(std::min<size_t>(options.repeats, repeatBegin + (range.end - task)));
+
+        auto [p1, p2] = pairs[pairIndex];
+        // Collecting round metrics bypasses the pairing cache, which only holds scores
+        auto [p1Scores, p2Scores] = metrics
+            ? playRepeats(registry.getName(p1), registry.getName(p2), repeatBegin, repeatEnd, metrics->at(p1, p2))
+            : runIPD(registry.getName(p1), registry.getName(p2), repeatBegin, repeatEnd);
+        results.push_back({ p1, p2, p1Scores, p2Scores });
+
+        // Text output follows each pairing's rounds, so only complete pairings are reported here
+        if (options.format == "text" && !options.evolve && repeatBegin == 0 && repeatEnd == options.repeats) {
+            outputPairwisePayoffsStats(registry.getName(p1), registry.getName(p2), calculateStatistics(p1Scores, p2Scores));
+        }
+
+        task += repeatEnd - repeatBegin;
+
+        if (options.maxMemory > 0) {
+            MemoryBudget(options.maxMemory).check("running pairings");
+        }
+    }
+
+    return results;
+}
+
+template <typename T>
+std::vector<PairResult> TournamentManager<T>::playShard(const StrategyRegistry& registry, int shard, int shardCount) {
+    auto pairs = tournamentPairs(registry);
+    return runTasks(registry, pairs, Sharding::taskRange(pairs.size() * options.repeats, shard, shardCount));
+}
+
+template <typename T>
+StrategyMatrix<MatchStatistics> TournamentManager<T>::playRoundRobin(const StrategyRegistry& registry, StrategyMatrix<TournamentMetrics>* metrics) {
+    StrategyMatrix<MatchStatistics> allResults(registry.size());
+    auto pairs = tournamentPairs(registry);
+    std::string optionsKey = Sharding::optionsKey(options);
+
+    std::vector<PairResult> partialResults;
+    if (options.shardCount > 0) {
+        std::string directory = options.shardDirectory.empty() ? createFilename("shards", "") : options.shardDirectory;
+        std::cout << "Running " << options.shardCount << " shards in: " << directory << std::endl;
+        Sharding::runMissingWorkers(options, directory);
+
+        for (int shard = 0; shard < options.shardCount; ++shard) {
+            auto shardResults = Sharding::readShard(Sharding::shardFilename(directory, shard, options.shardCount), optionsKey);
+            partialResults.insert(partialResults.end(), shardResults.begin(), shardResults.end());
+        }
+    }
+    else {
+        // Metrics for a pairing live in one matrix cell, so its repeats are never split across workers
+        partialResults = runScheduled(registry, pairs, metrics == nullptr, metrics);
+    }
+
+    // Merge partial accumulators, which may split a pairing's repeats across shards
+    StrategyMatrix<std::pair<ScoreAccumulator, ScoreAccumulator>> merged(registry.size());
+    for (const auto& result : partialResults) {
+        merged.at(result.p1, result.p2).first.merge(result.p1Scores);
+        merged.at(result.p1, result.p2).second.merge(result.p2Scores);
+    }
+
+    for (auto [i, j] : pairs) {
+        MatchStatistics stats = calculateStatistics(merged.at(i, j).first, merged.at(i, j).second);
+        allResults.at(i, j) = stats;
+        if (i == j) {
+            continue;
+        }
+        if (metrics) {
+            metrics->at(j, i) = metrics->at(i, j).mirrored();
+        }
+
+        // Populate reverse entries
+        MatchStatistics statsReverse = stats;
+        std::swap(statsReverse.p1Mean, statsReverse.p2Mean);
+        std::swap(statsReverse.p1Stdev, statsReverse.p2Stdev);
+        std::swap(statsReverse.p1CILower, statsReverse.p2CILower);
+        std::swap(statsReverse.p1CIUpper, statsReverse.p2CIUpper);
+
+        allResults.at(j, i) = statsReverse;
+    }
+
+    return allResults;
+}
+
+// Plays one repeat of one pairing exactly as the tournament did, printing every round.
+// Repeats are numbered from 1, as in the text output. The tournament seats whichever strategy
+// comes first in --strategies as player 1 and mirrors the reverse seating, so a pair asked for the
+// other way round is played in that order and printed with the seats swapped back.
+template <typename T>
+void TournamentManager<T>::replayMatch(int repetition) {
+    const std::string& strat1 = options.replayStrategies[0];
+    const std::string& strat2 = options.replayStrategies[1];
+    StrategyRegistry registry(options.strategies);
+    bool swapped = registry.getId(strat1) > registry.getId(strat2);
+    int r = repetition - 1;
+
+    std::cout << "=====REPLAYING MATCH=====: " << strat1 << " vs " << strat2 << " | repetition " << repetition << " of " << options.repeats
+        << " | " << options.rounds << " rounds | ";
     if (options.noiseOn) {
         std::cout << "epsilon: " << options.epsilon << " | seed: " << options.seed << "\n";
     }
     else {
         std::cout << "epsilon: 0.0 | seed: 0\n";
     }
+    if (swapped) {
+        std::cout << "- Played as " << strat2 << " vs " << strat1 << ", the tournament's seating, and printed with the seats swapped\n";
+    }
 
-    for (size_t i = 0; i < stratList.size(); ++i) {
-        for (size_t j = i + 1; j < stratList.size(); ++j) {
-            auto [p1Scores, p2Scores] = runIPD(stratList[i], stratList[j]);
-            
-            MatchStatistics stats = calculateStatistics(p1Scores, p2Scores);
-            
-            if (options.format == "text") {
-                outputPairwisePayoffsStats(stratList[i], stratList[j], stats);
-            }
-            
-            allResults[{stratList[i], stratList[j]}] = stats;
+    RandomStream randNumGen(options.seed, r, RandomStream::noiseSeat);
+
+    auto p1Strategy = StrategyCreator::createSeededStrategy(swapped ? strat2 : strat1, options.seed, r, 1);
+    auto p2Strategy = StrategyCreator::createSeededStrategy(swapped ? strat1 : strat2, options.seed, r, 2);
+
+    GameManager<T> game(std::move(p1Strategy), std::move(p2Strategy), payoff, options.epsilon, randNumGen, options.noiseOn, "csv");
+    RoundMetrics<MoveHistory> history;
+    game.runGame(options.rounds, repetition, options.repeats, history);
+
+    // Same layout as the text output of GameManager, in the requested seat order
+    const Strategy& first = swapped ? *game.getPlayer2Strategy() : *game.getPlayer1Strategy();
+    const Strategy& second = swapped ? *game.getPlayer1Strategy() : *game.getPlayer2Strategy();
+    std::cout << "----------------------------------";
+    std::cout << "\nNext match: " << first << " vs " << second << "\nRepetition " << repetition << " of " << options.repeats << "\n\n";
+
+    double firstScore = 0.0;
+    double secondScore = 0.0;
+    int round = 1;
+    for (char move : history.getMoves()) {
+        bool seat1Cooperated = move & 1;
+        bool seat2Cooperated = move >> 1;
+        bool firstCooperated = swapped ? seat2Cooperated : seat1Cooperated;
+        bool secondCooperated = swapped ? seat1Cooperated : seat2Cooperated;
+        firstScore += payoff.calculatePayoff(firstCooperated, secondCooperated);
+        secondScore += payoff.calculatePayoff(secondCooperated, firstCooperated);
+
+        std::cout << "Round " << round++ << ": "
+            << first << " chose " << (firstCooperated ? "Cooperate" : "Defect")
+            << ", " << second << " chose " << (secondCooperated ? "Cooperate" : "Defect")
+            << " | Scores: " << firstScore << " - " << secondScore << "\n";
+    }
 
-            // Populate reverse entries
-            MatchStatistics statsReverse = stats;
-            std::swap(statsReverse.p1Mean, statsReverse.p2Mean);
-            std::swap(statsReverse.p1Stdev, statsReverse.p2Stdev);
-            std::swap(statsReverse.p1CILower, statsReverse.p2CILower);
-            std::swap(statsReverse.p1CIUpper, statsReverse.p2CIUpper);
+    std::cout << "\nResults:\n";
+    std::cout << first << " - Total Score: " << firstScore << "\n";
+    std::cout << second << " - Total Score: " << secondScore << "\n";
+}
 
-            allResults[{stratList[j], stratList[i]}] = statsReverse;
-        }
+template <typename T>
+void TournamentManager<T>::runTournament() {
+    StrategyRoster roster(options.strategies);
+    const StrategyRegistry& registry = roster.getRegistry();
+
+    if (options.maxMemory > 0) {
+        MemoryBudget(options.maxMemory).require(estimateTournamentBytes(registry.size(), tournamentPairs(registry).size()), "this tournament");
+    }
+
+    // Worker process: compute one shard, hand it to the coordinator and stop
+    if (options.shardIndex >= 0) {
+        std::string filename = Sharding::shardFilename(options.shardDirectory, options.shardIndex, options.shardCount);
+        Sharding::writeShard(filename, Sharding::optionsKey(options), playShard(registry, options.shardIndex, options.shardCount));
+        std::cout << "- Shard " << options.shardIndex << " of " << options.shardCount << " saved in: " << filename << "\n";
+        return;
+    }
+
+    std::cout << "=====RUNNING IPD TOURNAMENT=====: " << options.rounds << " rounds | " << options.repeats << " repeats | ";
+    if (options.noiseOn) {
+        std::cout << "epsilon: " << options.epsilon << " | seed: " << options.seed << "\n";
+    }
+    else {
+        std::cout << "epsilon: 0.0 | seed: 0\n";
     }
 
+    std::unique_ptr<StrategyMatrix<TournamentMetrics>> metrics;
+    if (options.metrics) {
+        metrics = std::make_unique<StrategyMatrix<TournamentMetrics>>(registry.size());
+    }
+
+    StrategyMatrix<MatchStatistics> allResults = playRoundRobin(registry, metrics.get());
+
     if (options.format == "csv") {
-        writePairwisePayoffsFile(allResults);
-        writePayoffMatrixFile(stratList, allResults);
-        writeLeaderboardFile(stratList, allResults);
+        writePairwisePayoffsFile(roster, allResults);
+        writePayoffMatrixFile(roster, allResults);
+        writeLeaderboardFile(roster, allResults);
+        if (metrics) {
+            writeRoundMetricsFile(roster, *metrics);
+            writeCooperationSeriesFile(roster, *metrics);
+        }
     }
 
     std::cout << "\n- Files located at: x64 -> Debug folder\n";
@@ -351,12 +764,10 @@ void TournamentManager<T>::runTournament() {
 }
 
 template <typename T>
-void TournamentManager<T>::writeEvolutionaryResultsFile(const std::vector<std::string>& strategies, const std::vector<std::map<std::string, double>>& populationHistory,
-    const std::map<std::pair<std::string, std::string>, MatchStatistics>& finalResults) const {
-
-    std::string filename = createFilename("evolutionary_results");
+std::ofstream TournamentManager<T>::openEvolutionaryResultsFile(const StrategyRoster& roster, std::string& outFilename) const {
+    outFilename = createFilename("evolutionary_results");
     
-    std::ofstream csv(filename);
+    std::ofstream csv(outFilename);
     if (!csv.is_open()) {
         throw std::runtime_error("Evolutionary results file could not be created");
     }
@@ -366,43 +777,99 @@ void TournamentManager<T>::writeEvolutionaryResultsFile(const std::vector<std::s
     csv << "Repeats: " << options.repeats << "\n";
     csv << "Population size: " << options.population << "\n";
     csv << "Generations: " << options.generations << "\n";
+    csv << "Dynamics: " << options.dynamics;
+    if (options.dynamics == "mutator") {
+        csv << " (mutation: " << options.mutation << ")";
+    }
+    else if (options.dynamics == "best-response") {
+        csv << " (response rate: " << options.responseRate << ")";
+    }
+    csv << "\n";
     csv << "Epsilon: " << (options.noiseOn ? std::to_string(options.epsilon) : "0.0") << "\n";
     csv << "Seed: " << (options.noiseOn ? std::to_string(options.seed) : "0") << "\n";
     csv << "SCB enabled: " << (options.scb ? "Yes" : "No") << "\n";
     csv << "Strategies: ";
-    for (const auto& strat : strategies) {
+    for (const auto& strat : roster.getLabels()) {
         csv << strat << " ";
     }
     csv << "\n\n";
 
     csv << "Generation";
-    for (const auto& strat : strategies) {
+    for (const auto& strat : roster.getLabels()) {
         csv << "," << strat;
     }  
     csv << "\n";
 
-    for (size_t gen = 0; gen < populationHistory.size(); gen++) {
-        csv << gen + 1;
+    return csv;
+}
 
-        for (const auto& strat : strategies) {
-            double share = 0.0;
+// Reopens a partially written results file from a checkpoint, dropping any rows written after the
+// snapshot. The file is copied line by line so the "Generations:" header can show a count raised
+// on resume.
+template <typename T>
+std::ofstream TournamentManager<T>::reopenEvolutionaryResultsFile(const std::string& filename, std::uint64_t validBytes) const {
+    std::string tempFilename = filename + ".tmp";
+    {
+        std::ifstream in(filename, std::ios::binary);
+        std::ofstream out(tempFilename, std::ios::binary | std::ios::trunc);
+        if (!in.is_open() || !out.is_open()) {
+            throw std::runtime_error("Evolutionary results file " + filename + " could not be resumed");
+        }
 
-            if (populationHistory[gen].count(strat)) {
-                share = populationHistory[gen].at(strat);
+        std::uint64_t copied = 0;
+        std::string line;
+        while (copied < validBytes && std::getline(in, line)) {
+            copied += line.size() + 1;
+            if (line.starts_with("Generations: ")) {
+                // Keep a carriage return left by a file written in text mode on Windows
+                std::string lineEnd = line.ends_with('\r') ? "\r" : "";
+                line = "Generations: " + std::to_string(options.generations) + lineEnd;
             }
-            csv << "," << (share / options.population) * 100.0;
+            out << line << "\n";
+        }
+
+        if (copied != validBytes || !out.good()) {
+            throw std::runtime_error("Evolutionary results file " + filename + " is shorter than its checkpoint and could not be resumed");
         }
-        csv << "\n";
     }
 
-    csv.close();
-    std::cout << "\n- Evolutionary results saved in: " << filename;
+    std::error_code error;
+    std::filesystem::rename(tempFilename, filename, error);
+    if (error) {
+        throw std::runtime_error("Evolutionary results file " + filename + " could not be resumed: " + error.message());
+    }
+
+    std::ofstream csv(filename, std::ios::app);
+    if (!csv.is_open()) {
+        throw std::runtime_error("Evolutionary results file " + filename + " could not be resumed");
+    }
+    return csv;
+}
+
+template <typename T>
+void TournamentManager<T>::appendEvolutionaryResultsRow(std::ofstream& csv, int generation, const std::vector<double>& population) const {
+    csv << generation;
+    for (double share : population) {
+        csv << "," << (share / options.population) * 100.0;
+    }
+    csv << "\n";
 }
 
 
 template <typename T>
-void TournamentManager<T>::writeEvolutionaryLeaderboardFile(const std::map<std::string, double>& finalPopulationShares) const {
-    std::string filename = "evolutionary_leaderboard.csv";
+std::string TournamentManager<T>::readEvolutionaryLeaderboardFile() const {
+    std::ifstream lbFile(evolutionaryLeaderboardFilename);
+    std::ostringstream contents;
+    if (lbFile.is_open()) {
+        contents << lbFile.rdbuf();
+    }
+    return contents.str();
+}
+
+// Merges the final shares into the given leaderboard contents and writes the result over the file
+template <typename T>
+void TournamentManager<T>::writeEvolutionaryLeaderboardFile(const StrategyRoster& roster, const std::vector<double>& finalPopulationShares, const std::string& previousLeaderboard) const {
+    std::string filename = evolutionaryLeaderboardFilename;
 
     struct LeaderboardEntry {
         std::string name;
@@ -413,8 +880,8 @@ void TournamentManager<T>::writeEvolutionaryLeaderboardFile(const std::map<std::
     std::map<std::string, LeaderboardEntry> leaderboardMerge;
 
     // Load existing leaderboard if it exists
-    std::ifstream lbFile(filename);
-    if (lbFile.is_open()) {
+    std::istringstream lbFile(previousLeaderboard);
+    {
         std::string line;
 
         std::getline(lbFile, line); // skip header
@@ -433,12 +900,19 @@ void TournamentManager<T>::writeEvolutionaryLeaderboardFile(const std::map<std::
                 leaderboardMerge[name] = { name, mean, 1 };
             }
         }
-        lbFile.close();
+    }
+
+    // Duplicate instances of a strategy pool their shares
+    const StrategyRegistry& registry = roster.getRegistry();
+    std::vector<double> strategyShares(registry.size(), 0.0);
+    for (size_t instance = 0; instance < roster.size(); ++instance) {
+        strategyShares[roster.getId(instance)] += finalPopulationShares[instance];
     }
 
     // // Merge new and current leaderboard
-    for (const auto& [name, share] : finalPopulationShares) {
-        double newMean = (share / options.population) * 100.0;
+    for (StrategyId id = 0; id < registry.size(); ++id) {
+        const std::string& name = registry.getName(id);
+        double newMean = (strategyShares[id] / options.population) * 100.0;
         if (leaderboardMerge.contains(name)) {
             auto& existing = leaderboardMerge[name];
             int total = existing.count + 1;
@@ -479,22 +953,136 @@ void TournamentManager<T>::writeEvolutionaryLeaderboardFile(const std::map<std::
     std::cout << "\n- Evolutionary leaderboard updated: " << filename;
 }
 
+// Map strategy name to complexity cost
+template <typename T>
+double TournamentManager<T>::scbCost(const std::string& name) const {
+    if (!options.scb) {
+        return 0.0;
+    }
+    if (name == "ALLC" || name == "ALLD" || name.starts_with("RND")) {
+        return 1.0;
+    }
+    if (name == "TFT" || name == "GRIM" || name == "PAVLOV" || name == "RIVAL") {
+        return 2.0;
+    }
+    if (name == "CTFT" || name == "PROBER" || name == "TROJAN") {
+        return 3.0;
+    }
+    return 0.0;
+}
+
+// Scheduler bookkeeping for one job: its task range and cost, its slot in the sort order and chunk
+// list, its result vector and the partial result it is merged from
+template <typename T>
+std::uint64_t TournamentManager<T>::schedulerJobBytes() {
+    return sizeof(ShardTaskRange) + sizeof(double) + 2 * sizeof(size_t) + sizeof(std::vector<PairResult>) + 2 * sizeof(PairResult);
+}
+
+// Memory for playing every pairing once, with the scheduler at one job per pairing (it only splits
+// pairings further when the budget allows). Scores are streamed into fixed-size accumulators, so
+// repeats add nothing here.
+template <typename T>
+std::uint64_t TournamentManager<T>::estimatePairingBytes(size_t pairCount) const {
+    std::uint64_t bytes = pairCount * schedulerJobBytes();
+
+    // One partial result for every pairing split across a shard boundary
+    bytes += std::max(options.shardCount, 0) * sizeof(PairResult);
+
+    // Every new pairing may be added to a shared cache, up to its capacity
+    if (pairCache) {
+        std::uint64_t keyLength = pairCacheKey("RND0.123456789", "RND0.123456789").size();
+        bytes += std::min<std::uint64_t>(pairCount, pairCache->getCapacity()) * PairResultCache::entryBytes(keyLength);
+    }
+    return bytes;
+}
+
+// Containers that grow with the strategy list
+template <typename T>
+std::uint64_t TournamentManager<T>::estimateTournamentBytes(size_t strategyCount, size_t pairCount) const {
+    std::uint64_t cells = static_cast<std::uint64_t>(strategyCount) * strategyCount;
+    std::uint64_t bytes = cells * (sizeof(MatchStatistics) + 2 * sizeof(ScoreAccumulator));
+    bytes += estimatePairingBytes(pairCount);
+
+    if (options.metrics) {
+        // The matrix, plus each thread's copy of one game's metrics when a game stands in for all repeats
+        std::uint64_t metricsBytes = sizeof(TournamentMetrics) + 2 * sizeof(std::uint32_t) * options.rounds;
+        bytes += (cells + std::max(options.threads, 1)) * metricsBytes;
+    }
+    return bytes;
+}
+
+template <typename T>
+std::uint64_t TournamentManager<T>::estimateEvolutionBytes(size_t strategyCount, size_t instanceCount) const {
+    // Fitness by strategy while it is built, then by instance
+    std::uint64_t bytes = (static_cast<std::uint64_t>(strategyCount) * strategyCount
+        + static_cast<std::uint64_t>(instanceCount) * instanceCount) * sizeof(double);
+
+    // Every pairing of the strategies is played once to build the fitness matrix
+    bytes += estimatePairingBytes(strategyCount * (strategyCount + 1) / 2);
+
+    // Share vectors: cycle detection window, ODE stages and a checkpoint waiting to be written
+    bytes += 64 * static_cast<std::uint64_t>(instanceCount) * sizeof(double);
+    return bytes;
+}
+
+// Pair payoffs do not change between generations, so every pairing is played once up front.
+// fitnessMatrix(a, b) holds instance a's SCB-adjusted mean payoff against instance b, which turns
+// each generation's fitness calculation into a single matrix-vector product. Each unordered pair of
+// distinct strategies is simulated once and both seats are read from it; instances sharing a
+// strategy reuse that strategy's row. Stochastic strategies (RND, TROJAN) are therefore sampled
+// once, over --repeats games, rather than drawing new games every generation.
+template <typename T>
+std::shared_ptr<const StrategyMatrix<double>> TournamentManager<T>::buildFitnessMatrix(const StrategyRoster& roster) {
+    const StrategyRegistry& registry = roster.getRegistry();
+    StrategyMatrix<double> strategyFitness(registry.size(), 0.0);
+
+    // Whole pairings only, so every result can come from or go to the pairing cache
+    for (const auto& result : runScheduled(registry, tournamentPairs(registry), false)) {
+        StrategyId i = result.p1;
+        StrategyId j = result.p2;
+        MatchStatistics stats = calculateStatistics(result.p1Scores, result.p2Scores);
+
+        if (i == j) {
+            // Both seats belong to the same strategy, so self-play fitness averages them
+            strategyFitness.at(i, i) = (stats.p1Mean + stats.p2Mean) / 2.0;
+        }
+        else {
+            strategyFitness.at(i, j) = stats.p1Mean;
+            strategyFitness.at(j, i) = stats.p2Mean;
+        }
+    }
+
+    size_t instanceCount = roster.size();
+    auto fitnessMatrix = std::make_shared<StrategyMatrix<double>>(instanceCount, 0.0);
+    for (size_t a = 0; a < instanceCount; a++) {
+        double cost_a = scbCost(registry.getName(roster.getId(a)));
+
+        for (size_t b = 0; b < instanceCount; b++) {
+            fitnessMatrix->at(a, b) = strategyFitness.at(roster.getId(a), roster.getId(b)) - cost_a; // Apply SCB cost of strategy
+        }
+    }
+
+    return fitnessMatrix;
+}
+
 template <typename T>
 void TournamentManager<T>::runEvolutionaryTournament() {
-    std::vector<std::map<std::string, double>> populationHistory;
-    std::vector<std::string> stratList = options.strategies;
+    StrategyRoster roster(options.strategies);
+    size_t stratCount = roster.size();
     
     int populationSize = options.population;
-    std::map<std::string, double> population;
-    double totalShared = 1.0 / stratList.size(); // Equal population shares
-    for (const auto& strat : stratList) {
-        population[strat] = totalShared;
-    }
+    std::vector<double> population(stratCount, static_cast<double>(populationSize) / stratCount); // Equal population shares
         
     int generations = options.generations;
 
     std::cout << "\n=====RUNNING IPD EVOLUTIONARY TOURNAMENT=====: " << options.rounds << " rounds | " << options.repeats << " repeats | ";
-    std::cout << "population: " << populationSize << " | generations: " << generations;
+    std::cout << "population: " << populationSize << " | generations: " << generations << " | dynamics: " << options.dynamics;
+    if (options.dynamics == "mutator") {
+        std::cout << " (mutation: " << options.mutation << ")";
+    }
+    else if (options.dynamics == "best-response") {
+        std::cout << " (response rate: " << options.responseRate << ")";
+    }
     if (options.noiseOn) {
         std::cout << " | epsilon: " << options.epsilon << " | seed: " << options.seed << "\n";
     }
@@ -509,107 +1097,154 @@ void TournamentManager<T>::runEvolutionaryTournament() {
         std::cout << "Strategic Complexity Budget disabled\n";
     }
 
-    // Lambda to map strategy name to complexity cost
-    auto scbCost = [&](const std::string& name) -> double {
-        if (!options.scb) {
-            return 0.0;
-        }
-        if (name == "ALLC" || name == "ALLD" || name.starts_with("RND")) {
-            return 1.0;
-        }
-        if (name == "TFT" || name == "GRIM" || name == "PAVLOV" || name == "RIVAL") {
-            return 2.0;
-        }
-        if (name == "CTFT" || name == "PROBER" || name == "TROJAN" ) {
-            return 3.0;   
-        }  
-        return 0.0;
-     };
+    if (options.maxMemory > 0) {
+        MemoryBudget(options.maxMemory).require(estimateEvolutionBytes(roster.getRegistry().size(), stratCount), "this evolutionary run");
+    }
 
-    std::map<std::pair<std::string, std::string>, MatchStatistics> results;
+    std::string optionsKey = Checkpoint::optionsKey(options);
+    std::shared_ptr<const StrategyMatrix<double>> fitnessMatrix;
+    EvolutionCheckpoint resumed;
+    int startGeneration = 1;
 
-    for (int gen = 1; gen <= generations; gen++) {
-        if (options.format == "text") {
-            std::cout << "----------------------------------";
-            std::cout << "\nGENERATION " << gen << "\n";
+    if (!options.resumePath.empty()) {
+        resumed = Checkpoint::load(options.resumePath);
+        if (resumed.optionsKey != optionsKey) {
+            throw std::invalid_argument("Error - checkpoint " + options.resumePath + " was created with different options");
         }
+        fitnessMatrix = resumed.fitnessMatrix;
+        startGeneration = resumed.generation + 1;
+        std::cout << "Resuming from checkpoint " << options.resumePath << " after generation " << resumed.generation << "\n";
+    }
+    else {
+        fitnessMatrix = buildFitnessMatrix(roster);
+    }
 
-        
-        std::map<std::string, double> fitness;
-
-        for (size_t i = 0; i < stratList.size(); i++) {
-            double fitnessTotal = 0.0;
-
-            const std::string& strat_i = stratList[i];
-            double cost_i = scbCost(strat_i);
-
-            for (size_t j = 0; j < stratList.size(); j++) {
-                if (i == j) {
-                    continue;
-                }
-                const std::string& strat_j = stratList[j];
-
-                auto [p1Scores, p2Scores] = runIPD(stratList[i], stratList[j]);
+    EvolutionaryDynamics dynamics(*fitnessMatrix, EvolutionaryDynamics::parseType(options.dynamics), options.mutation, options.responseRate);
+    if (!options.resumePath.empty()) {
+        dynamics.restoreState(resumed.dynamicsState);
+        for (size_t i = 0; i < stratCount; i++) {
+            population[i] = dynamics.getShares()[i] * populationSize;
+        }
+    }
 
-                MatchStatistics stats = calculateStatistics(p1Scores, p2Scores);
-                results[{stratList[i], stratList[j]}] = stats;
+    // History streams straight to the results file rather than accumulating in memory
+    std::string historyFilename;
+    std::ofstream historyFile;
+    if (options.format == "csv") {
+        if (!resumed.historyPath.empty()) {
+            historyFilename = resumed.historyPath;
+            historyFile = reopenEvolutionaryResultsFile(historyFilename, resumed.historyBytes);
+        }
+        else {
+            historyFile = openEvolutionaryResultsFile(roster, historyFilename);
+        }
+    }
 
-                double scbMeanAdjustment = stats.p1Mean - cost_i; // Apply SCB cost of strategy
+    std::unique_ptr<CheckpointWriter> checkpointWriter;
+    if (!options.checkpointPath.empty()) {
+        checkpointWriter = std::make_unique<CheckpointWriter>(options.checkpointPath);
+    }
 
-                fitnessTotal += scbMeanAdjustment * population[strat_j]; // Average fitness (payoff) of strategy * current proportion of strategy
-            }
+    // Leaderboard the final shares are merged into. A resumed run that had already finished merges
+    // into the leaderboard as it was before, replacing its earlier entry instead of adding a second one.
+    bool leaderboardMerged = false;
+    std::string previousLeaderboard;
+    if (options.format == "csv") {
+        previousLeaderboard = resumed.leaderboardMerged ? resumed.leaderboardBefore : readEvolutionaryLeaderboardFile();
+    }
 
-            fitness[stratList[i]] = fitnessTotal;
+    auto saveCheckpoint = [&](int gen) {
+        EvolutionCheckpoint checkpoint;
+        checkpoint.optionsKey = optionsKey;
+        checkpoint.generation = gen;
+        checkpoint.leaderboardMerged = leaderboardMerged;
+        checkpoint.leaderboardBefore = previousLeaderboard;
+        checkpoint.dynamicsState = dynamics.saveState();
+        checkpoint.fitnessMatrix = fitnessMatrix;
+        if (historyFile.is_open()) {
+            historyFile.flush();
+            checkpoint.historyPath = historyFilename;
+            checkpoint.historyBytes = static_cast<std::uint64_t>(historyFile.tellp());
         }
+        checkpointWriter->submit(std::move(checkpoint));
+    };
 
-        // Denominator of simple proportional selection equation
-        double totalFitnessWeight = 0.0;
-        for (auto& [name, share] : population) {
-            totalFitnessWeight += share * fitness[name];
+    int lastGeneration = startGeneration - 1;
+    for (int gen = startGeneration; gen <= generations && !dynamics.hasConverged(); gen++) {
+        if (options.format == "text") {
+            std::cout << "----------------------------------";
+            std::cout << "\nGENERATION " << gen << "\n";
         }
 
-		// Calculate new population shares
-        std::map<std::string, double> newPopulation;
-        for (auto& [name, share] : population) {
-            newPopulation[name] = (share * fitness[name]) / totalFitnessWeight;
-        }
-        
-        // Scale by total population size
-        for (auto& [name, share] : newPopulation) {
-            share *= populationSize;
+        dynamics.step();
+        lastGeneration = gen;
+
+        // Scale shares by total population size
+        const std::vector<double>& shares = dynamics.getShares();
+        for (size_t i = 0; i < stratCount; i++) {
+            population[i] = shares[i] * populationSize;
         }
-            
-        population = newPopulation;
 
-		populationHistory.push_back(population);
+        if (historyFile.is_open()) {
+            appendEvolutionaryResultsRow(historyFile, gen, population);
+        }
 
         if (options.format == "text") {
             std::cout << "----------------------------------";
             std::cout << "\n Generation " << gen << " distribution:\n";
-            for (auto& [name, share] : population) {
-                std::cout << "  " << name << ": " << (share / populationSize) * 100 << "%\n";
+            for (size_t id = 0; id < stratCount; id++) {
+                std::cout << "  " << roster.getLabel(id) << ": " << (population[id] / populationSize) * 100 << "%\n";
             }
         }
+
+        // Stop early once the population has settled on a fixed point or a repeating cycle
+        if (dynamics.hasConverged()) {
+            if (dynamics.getCycleLength() == 1) {
+                std::cout << "Population reached a fixed point at generation " << gen << "\n";
+            }
+            else {
+                std::cout << "Population entered a cycle of length " << dynamics.getCycleLength() << " at generation " << gen << "\n";
+            }
+        }
+
+        if (checkpointWriter && (gen % options.checkpointInterval == 0 || gen == generations || dynamics.hasConverged())) {
+            saveCheckpoint(gen);
+        }
+    }
+
+    if (checkpointWriter) {
+        checkpointWriter->finish();
+        std::cout << "\n- Checkpoint saved in: " << options.checkpointPath;
     }
 
     if (options.format == "text") {
         std::cout << "----------------------------------";
         std::cout << "\nFINAL POPULATION SHARES:\n";
 
-        std::vector<std::pair<std::string, double>> sortedPopulation(population.begin(), population.end());
+        std::vector<size_t> sortedPopulation(stratCount);
+        std::iota(sortedPopulation.begin(), sortedPopulation.end(), 0);
         // Descending by share
-        std::sort(sortedPopulation.begin(), sortedPopulation.end(),[](const auto& a, const auto& b) {
-            return a.second > b.second;
+        std::sort(sortedPopulation.begin(), sortedPopulation.end(), [&](size_t a, size_t b) {
+            return population[a] > population[b];
         });
 
-        for (auto& [name, share] : sortedPopulation) {
-            std::cout << "  " << name << ": " << (share / populationSize) * 100 << "%\n";
+        for (size_t id : sortedPopulation) {
+            std::cout << "  " << roster.getLabel(id) << ": " << (population[id] / populationSize) * 100 << "%\n";
         }
     }
 
     if (options.format == "csv") {
-        writeEvolutionaryResultsFile(stratList, populationHistory, results);
-        writeEvolutionaryLeaderboardFile(population);
+        historyFile.flush();
+        std::cout << "\n- Evolutionary results saved in: " << historyFilename;
+        writeEvolutionaryLeaderboardFile(roster, population, previousLeaderboard);
+        leaderboardMerged = true;
+
+        // Record the merge in the checkpoint, so a resume redoes it rather than repeating it
+        if (checkpointWriter) {
+            saveCheckpoint(lastGeneration);
+            checkpointWriter->finish();
+        }
+        historyFile.close();
     }
 
     std::cout << "\n=========TOURNAMENT CONCLUDED=============================================================\n";
@@ -1,7 +1,7 @@
 #include "trojan_strategy.hpp"
 
-TROJAN::TROJAN()
-    : opponentHistory(), exploitable(-1), opponentDefects(0), coopRounds(5), probeRound(6), exploitFailThreshold(3), coopModeRound(0), coopMode(false), randNumGen(std::random_device{}()), 
+TROJAN::TROJAN(RandomStream randNumGen)
+    : opponentHistory(), exploitable(-1), opponentDefects(0), coopRounds(5), probeRound(6), exploitFailThreshold(3), coopModeRound(0), coopMode(false), randNumGen(randNumGen), 
     rangeLimit(5, 10)                    
 {
     coopRounds = rangeLimit(randNumGen);
@@ -78,6 +78,6 @@ Action TROJAN::decideAction(const GameState& state) {
     return state.lastOpponentMove;
 }
 
-std::string TROJAN::name() const {
+std::string_view TROJAN::name() const {
     return "TROJAN";
 }
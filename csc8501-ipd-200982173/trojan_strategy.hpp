@@ -3,15 +3,17 @@
 #include <random>
 #include "strategy.hpp"
 #include "game_state.hpp"
+#include "random_stream.hpp"
 
 class TROJAN : public Strategy {
 public:
-    TROJAN();
+    explicit TROJAN(RandomStream randNumGen);
 
     Action decideAction(const GameState& state) override;
-    std::string name() const override;
+    std::string_view name() const override;
+    bool isDeterministic() const override { return false; }
 private:
-    std::mt19937 randNumGen;
+    RandomStream randNumGen;
     std::uniform_int_distribution<int> rangeLimit;
     std::vector<Action> opponentHistory;
     int exploitable; // -1 = undecided, 0 = not exploitable, 1 = exploitable